@@ -59,10 +59,6 @@ namespace fulla::bpt::concepts {
         // Check
         { n.is_valid() } -> std::convertible_to<bool>;
 
-        // Parent
-        { n.set_parent(typename NodeT::node_id_type{}) };
-        { n.get_parent() } -> std::convertible_to <typename NodeT::node_id_type>;
-
         { n.self() } -> std::convertible_to <typename NodeT::node_id_type>;
     };
 
@@ -99,6 +95,74 @@ namespace fulla::bpt::concepts {
         { n.get_prev() } -> std::convertible_to<typename LeafNodeT::node_id_type>;
     };
 
+    // Optional: the node stores the id of its parent. Without it the tree keeps
+    // the parent links itself (see tree::parent_of).
+    template <typename NodeT>
+    concept NodeParentLink = requires (NodeT n) {
+        { n.set_parent(typename NodeT::node_id_type{}) };
+        { n.get_parent() } -> std::convertible_to <typename NodeT::node_id_type>;
+    };
+
+    // Optional: inodes keep a right-link to the next inode of the same level, like
+    // the leaves do (B-link tree). The tree maintains it through splits and merges.
+    template <typename InodeT>
+    concept InodeRightLink = requires (InodeT n) {
+        { n.set_next(typename InodeT::node_id_type{}) };
+        { n.get_next() } -> std::convertible_to<typename InodeT::node_id_type>;
+    };
+
+    // Optional: inodes keep, next to every child, the number of elements stored under
+    // it. The tree maintains the counts and answers rank / nth / count queries with them.
+    template <typename InodeT>
+    concept InodeChildCounts = requires (InodeT n, const InodeT cn) {
+        { cn.get_count(std::size_t{}) } -> std::convertible_to<std::size_t>;
+        { n.set_count(std::size_t{}, std::size_t{}) };
+    };
+
+    // Optional: how full the node is in [0, 1]. Models that store variable-length
+    // entries report bytes here; otherwise the tree falls back to size() / capacity().
+    template <typename NodeT>
+    concept NodeFillRatio = requires (const NodeT n) {
+        { n.fill_ratio() } -> std::convertible_to<double>;
+    };
+
+    // Optional: the model builds a short separator `s` with left < s <= right
+    // (suffix truncation). Leaf splits promote it instead of the full first key of the right node.
+    template <typename ModelT>
+    concept ModelSeparator = requires (ModelT m, typename ModelT::key_like_type k) {
+        { m.make_separator(k, k) } -> std::convertible_to<typename ModelT::key_borrow_type>;
+    };
+
+    // Optional: exact-match lookup in a leaf, the position of `k` or size() when it's missing.
+    // tree::find() uses it instead of key_position() + keys_eq().
+    template <typename LeafNodeT, typename KeyLikeT>
+    concept LeafFindKey = requires (const LeafNodeT n, const KeyLikeT& k) {
+        { n.find_key(k) } -> std::convertible_to<std::size_t>;
+    };
+
+    // Optional: the leaf keeps resources outside the node for some values (out-of-line
+    // storage). The tree calls release_value(pos) before it erases an element for good,
+    // and not when it moves elements between nodes.
+    template <typename LeafNodeT>
+    concept LeafReleaseValue = requires (LeafNodeT n, std::size_t pos) {
+        n.release_value(pos);
+    };
+
+    // Optional: loading nodes and reading keys and values has no side effects in the model
+    // (no caches, pins or counters), so locked_tree runs lookups in parallel.
+    template <typename ModelT>
+    concept ModelConcurrentReads = requires {
+        requires ModelT::concurrent_reads;
+    };
+
+    // Optional: a node id of one model is valid in another one over the same storage (both
+    // read the pages of one buffer manager), so tree::split_at() and tree::join() hand
+    // nodes from one tree to the other instead of copying their elements.
+    template <typename ModelT>
+    concept ModelSharedNodes = requires (const ModelT& a, const ModelT& b) {
+        { a.shares_nodes_with(b) } -> std::convertible_to<bool>;
+    };
+
     template <typename AccessT, typename NodeId, typename INodeT, typename LeafT>
     concept NodeAccessor = requires(AccessT a, NodeId id) {
         // Create:
@@ -157,6 +221,10 @@ namespace fulla::bpt::concepts {
             { m.value_borrow_as_in(vbor) } -> std::convertible_to<typename ModelT::value_in_type>;
         };
 
+        requires requires(typename ModelT::key_like_type k) {
+            { m.key_less(k, k) } -> std::convertible_to<bool>;
+        };
+
         requires NodeAccessor<
             typename ModelT::accessor_type,
             typename ModelT::node_id_type,
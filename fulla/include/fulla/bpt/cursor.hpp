@@ -8,6 +8,137 @@
 
 #pragma once
 
+#include <cstddef>
+#include <utility>
+
+#include "fulla/bpt/concepts.hpp"
+
 namespace fulla::bpt {
 
+    /// Forward/backward scan over the leaf level that keeps the current leaf loaded
+    /// (for the paged model: pinned in the buffer manager). Keys and values are read
+    /// straight from the held leaf; a new leaf is loaded only when the cursor crosses
+    /// a leaf boundary.
+    /// Any modification of the tree invalidates the cursor.
+    template <concepts::BptModel ModelT>
+    class cursor {
+    public:
+        using model_type = ModelT;
+        using leaf_type = typename model_type::leaf_type;
+        using node_id_type = typename model_type::node_id_type;
+        using key_out_type = typename model_type::key_out_type;
+        using value_out_type = typename model_type::value_out_type;
+
+        cursor() = default;
+
+        cursor(model_type& model, leaf_type leaf, std::size_t idx)
+            : model_(&model)
+            , leaf_(std::move(leaf))
+            , idx_(idx)
+        {
+            if (leaf_.is_valid()) {
+                size_ = leaf_.size();
+                if (idx_ >= size_) {
+                    next_leaf();
+                }
+            }
+        }
+
+        bool is_valid() const noexcept {
+            return (model_ != nullptr) && leaf_.is_valid();
+        }
+
+        explicit operator bool() const noexcept {
+            return is_valid();
+        }
+
+        key_out_type key() const {
+            return leaf_.get_key(idx_);
+        }
+
+        value_out_type value() const {
+            return leaf_.get_value(idx_);
+        }
+
+        std::pair<key_out_type, value_out_type> operator *() const {
+            return { key(), value() };
+        }
+
+        node_id_type node_id() const {
+            return is_valid() ? leaf_.self() : model_->get_invalid_node_id();
+        }
+
+        std::size_t position() const noexcept {
+            return idx_;
+        }
+
+        /// Moves to the next element; returns false once the cursor runs past the last one.
+        bool next() {
+            if (!is_valid()) {
+                return false;
+            }
+            if (++idx_ < size_) {
+                return true;
+            }
+            return next_leaf();
+        }
+
+        /// Moves to the previous element; returns false once the cursor runs past the first one.
+        bool prev() {
+            if (!is_valid()) {
+                return false;
+            }
+            if (idx_ > 0) {
+                --idx_;
+                return true;
+            }
+            return prev_leaf();
+        }
+
+    private:
+
+        bool next_leaf() {
+            auto next_id = leaf_.get_next();
+            while (model_->is_valid_id(next_id)) {
+                leaf_ = model_->get_accessor().load_leaf(next_id);
+                size_ = leaf_.size();
+                idx_ = 0;
+                if (size_ > 0) {
+                    return true;
+                }
+                next_id = leaf_.get_next();
+            }
+            reset();
+            return false;
+        }
+
+        bool prev_leaf() {
+            auto prev_id = leaf_.get_prev();
+            while (model_->is_valid_id(prev_id)) {
+                leaf_ = model_->get_accessor().load_leaf(prev_id);
+                size_ = leaf_.size();
+                if (size_ > 0) {
+                    idx_ = size_ - 1;
+                    return true;
+                }
+                prev_id = leaf_.get_prev();
+            }
+            reset();
+            return false;
+        }
+
+        void reset() {
+            leaf_ = leaf_type{};
+            idx_ = 0;
+            size_ = 0;
+        }
+
+        model_type* model_ = nullptr;
+        // a handle, not the leaf itself; models whose get_value() is non-const (the memory
+        // model hands out references into the node) still read through a const cursor
+        mutable leaf_type leaf_{};
+        std::size_t idx_ = 0;
+        std::size_t size_ = 0;
+    };
+
 } // namespace fulla::bpt
@@ -0,0 +1,133 @@
+/*
+ * File: locked.hpp
+ * Author: newenclave
+ * GitHub: https://github.com/newenclave
+ * Created: 2025-11-18
+ * License: MIT
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+#include "fulla/bpt/concepts.hpp"
+#include "fulla/bpt/policies.hpp"
+#include "fulla/bpt/tree.hpp"
+
+namespace fulla::bpt {
+
+    // Coarse-locked front end for tree: one reader/writer lock guards the whole tree, there
+    // are no per-node latches. Writers hold the tree exclusively. Lookups share it when
+    // the model says its reads have no side effects (concepts::ModelConcurrentReads); with
+    // any other model, e.g. one reading through a buffer manager, they take turns with the
+    // writers too, so paged trees get no parallelism from it.
+    // Lookups hand the entry to a callback instead of returning an iterator: the entry
+    // is only valid while the lock is held. New lookups wait while a writer is queued, so
+    // a steady stream of readers can't starve the writers.
+    template <concepts::BptModel ModelT>
+    class locked_tree {
+    public:
+
+        using tree_type = tree<ModelT>;
+        using model_type = ModelT;
+        using key_like_type = typename tree_type::key_like_type;
+        using key_out_type = typename tree_type::key_out_type;
+        using value_in_type = typename tree_type::value_in_type;
+        using value_out_type = typename tree_type::value_out_type;
+
+        constexpr static const bool shared_reads = concepts::ModelConcurrentReads<model_type>;
+
+        locked_tree() = default;
+
+        template <typename ...Args>
+        locked_tree(Args&&...args) : tree_(std::forward<Args>(args)...) {}
+
+        locked_tree(const locked_tree&) = delete;
+        locked_tree& operator = (const locked_tree&) = delete;
+
+        bool insert(const key_like_type& key, value_in_type value,
+            policies::insert ip = policies::insert::insert) {
+            return exclusive([&](tree_type& t) {
+                return t.insert(key, std::move(value), ip);
+            });
+        }
+
+        bool remove(const key_like_type& key) {
+            return exclusive([&](tree_type& t) {
+                return t.remove(key);
+            });
+        }
+
+        // Calls `f(key_out_type, value_out_type)` if the tree holds `key`.
+        template <typename F>
+        bool find(const key_like_type& key, F&& f) {
+            return read([&](tree_type& t) {
+                auto [node_id, pos, found] = t.locate_(key);
+                if (found) {
+                    auto leaf = t.get_accessor().load_leaf(node_id);
+                    f(leaf.get_key(pos), leaf.get_value(pos));
+                }
+                return found;
+            });
+        }
+
+        bool contains(const key_like_type& key) {
+            return read([&](tree_type& t) {
+                return t.locate_(key).found;
+            });
+        }
+
+        // Anything else (iteration, bulk loads, cursors) runs with the tree held exclusively.
+        template <typename F>
+        decltype(auto) exclusive(F&& f) {
+            {
+                std::lock_guard queue_lock(queue_mtx_);
+                ++writers_;
+            }
+            std::unique_lock lock(mtx_);
+            writer_left_queue();
+            return f(tree_);
+        }
+
+    private:
+
+        template <typename F>
+        decltype(auto) read(F&& f) {
+            if constexpr (shared_reads) {
+                {
+                    std::unique_lock queue_lock(queue_mtx_);
+                    no_writers_.wait(queue_lock, [this]() { return writers_ == 0; });
+                }
+                std::shared_lock lock(mtx_);
+                return f(tree_);
+            }
+            else {
+                return exclusive(std::forward<F>(f));
+            }
+        }
+
+        // The writer holds the tree now; the readers that queued behind the last waiting
+        // writer go on to wait for the tree lock itself.
+        void writer_left_queue() {
+            bool last = false;
+            {
+                std::lock_guard queue_lock(queue_mtx_);
+                last = (--writers_ == 0);
+            }
+            if (last) {
+                no_writers_.notify_all();
+            }
+        }
+
+        tree_type tree_;
+        std::shared_mutex mtx_;
+        // writers waiting for mtx_; new readers block while there are any
+        std::mutex queue_mtx_;
+        std::condition_variable no_writers_;
+        std::size_t writers_ = 0;
+    };
+
+} // namespace fulla::bpt
@@ -42,6 +42,10 @@ namespace fulla::bpt::memory::container {
         }
         node_id_type last_child_ = {};
         core::static_vector<node_id_type, max_elements> children_;
+        // elements under every child, aligned with children_ / last_child_ (models with
+        // ChildCounts only)
+        std::size_t last_count_ = 0;
+        core::static_vector<std::size_t, max_elements> counts_;
     };
 
     template <typename NodeIdT, typename KeyT, typename valueT, std::size_t MaxElements>
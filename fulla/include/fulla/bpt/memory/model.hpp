@@ -13,12 +13,19 @@
 
 namespace fulla::bpt::memory {
 
-    template <typename KeyT, typename ValueInT, std::size_t KeysMax = 5, typename LessT = std::less<KeyT>>
+    // ChildCounts: inodes keep the number of elements under each child, which gives the
+    // tree rank / nth / count in O(log n) at the cost of updating the path on every change.
+    template <typename KeyT, typename ValueInT, std::size_t KeysMax = 5, typename LessT = std::less<KeyT>,
+        bool ChildCounts = false>
     struct model {
 
         using key_type = KeyT;
         using value_type = ValueInT;
         using less_in_type = LessT;
+        constexpr static const bool child_counts = ChildCounts;
+
+        // nodes are plain heap objects, reading them changes nothing
+        constexpr static const bool concurrent_reads = true;
 
         struct key_like_type {
             explicit key_like_type(const key_type& val) : v(&val) {};
@@ -235,6 +242,9 @@ namespace fulla::bpt::memory {
             bool insert_child(std::size_t pos, const key_like_type &key, node_id_type id) {
                 impl()->keys_.emplace(impl()->keys_.begin() + pos, key.get());
                 impl()->children_.emplace(impl()->children_.begin() + pos, id);
+                if constexpr (child_counts) {
+                    impl()->counts_.emplace(impl()->counts_.begin() + pos, 0);
+                }
                 return true;
             }
 
@@ -251,9 +261,25 @@ namespace fulla::bpt::memory {
             bool erase(std::size_t pos) override {
                 impl()->keys_.erase(impl()->keys_.begin() + pos);
                 impl()->children_.erase(impl()->children_.begin() + pos);
+                if constexpr (child_counts) {
+                    impl()->counts_.erase(impl()->counts_.begin() + pos);
+                }
                 return true;
             }
 
+            std::size_t get_count(std::size_t pos) const requires child_counts {
+                return is_last(pos) ? impl()->last_count_ : impl()->counts_[pos];
+            }
+
+            void set_count(std::size_t pos, std::size_t value) requires child_counts {
+                if (is_last(pos)) {
+                    impl()->last_count_ = value;
+                }
+                else {
+                    impl()->counts_[pos] = value;
+                }
+            }
+
             bool is_last(std::size_t pos) const {
                 return impl()->children_.size() == pos;
             }
@@ -458,6 +484,10 @@ namespace fulla::bpt::memory {
             return value_in_type(k.get());
         }
 
+        static bool key_less(const key_like_type& a, const key_like_type& b) {
+            return cmp{}(a, b);
+        }
+
         static bool is_valid_id(const node_id_type& id) {
             return id.id != node_id_type::npos;
         }
@@ -0,0 +1,605 @@
+/*
+ * File: fixed_model.hpp
+ * Author: newenclave
+ * GitHub: https://github.com/newenclave
+ * Created: 2025-11-16
+ * License: MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <type_traits>
+
+#include "fulla/core/debug.hpp"
+#include "fulla/core/concepts.hpp"
+#include "fulla/core/simd.hpp"
+#include "fulla/bpt/concepts.hpp"
+#include "fulla/bpt/paged/model.hpp"
+
+#include "fulla/page/header.hpp"
+#include "fulla/page/page_view.hpp"
+#include "fulla/page/bpt_fixed.hpp"
+#include "fulla/page/metadata.hpp"
+#include "fulla/slots/directory.hpp"
+
+#include "fulla/page_allocator/concepts.hpp"
+
+namespace fulla::bpt::paged {
+
+    // Keys and values are copied into pages as they are (host byte order), so they have
+    // to be trivially copyable. Keys are ordered with operator <; 32/64-bit integer keys
+    // are searched with core::simd, anything else (e.g. std::array<std::byte, N>) with
+    // a plain binary search.
+    template <typename T>
+    concept FixedKey = std::is_trivially_copyable_v<T> && std::totally_ordered<T>;
+
+    template <typename T>
+    concept FixedValue = std::is_trivially_copyable_v<T> && std::default_initializable<T>;
+
+    struct fixed_bpt_descriptor {
+        using leaf_metadata_type = page::empty_metadata;
+        using inode_metadata_type = page::empty_metadata;
+        constexpr static const std::uint16_t leaf_kind_value = 3;
+        constexpr static const std::uint16_t inode_kind_value = 4;
+    };
+
+    // B+ tree model for fixed-size keys and values (secondary indexes on ids and alike).
+    // A page keeps its keys in one contiguous array, so key_position() searches the page
+    // in place without slot indirection or decoding.
+    template <page_allocator::concepts::PageAllocator PageAllocatorT,
+        FixedKey KeyT,
+        FixedValue ValueT,
+        core::concepts::RootManager RootManagerT = memory_root_manager<typename PageAllocatorT::pid_type>,
+        bpt::concepts::BptNodeDescriptor Descriptor = fixed_bpt_descriptor
+    >
+    struct fixed_model {
+
+        constexpr static const std::uint16_t leaf_kind_value = Descriptor::leaf_kind_value;
+        constexpr static const std::uint16_t inode_kind_value = Descriptor::inode_kind_value;
+        using leaf_metadata_type = Descriptor::leaf_metadata_type;
+        using inode_metadata_type = Descriptor::inode_metadata_type;
+        constexpr static const bool parent_links = descriptor_parent_links<Descriptor>();
+        constexpr static const bool inode_links = descriptor_inode_links<Descriptor>();
+
+        using root_manager_type = RootManagerT;
+        using buffer_manager_type = PageAllocatorT;
+        using pid_type = typename buffer_manager_type::pid_type;
+        using page_handle = typename buffer_manager_type::page_handle;
+        using page_view_type = page::page_view<slots::empty_directory_view>;
+
+        using key_type = KeyT;
+        using value_type = ValueT;
+        using less_type = std::less<key_type>;
+
+        using node_id_type = pid_type;
+        constexpr static const node_id_type invalid_node_value = std::numeric_limits<node_id_type>::max();
+
+        constexpr static const bool simd_search = core::simd::SearchWord<key_type>;
+
+        struct key_like_type {
+            key_type key{};
+        };
+
+        struct key_out_type {
+            key_type key{};
+        };
+
+        struct key_borrow_type {
+            key_type key{};
+        };
+
+        struct value_in_type {
+            value_type val{};
+        };
+
+        struct value_out_type {
+            value_type val{};
+        };
+
+        struct value_borrow_type {
+            value_type val{};
+        };
+
+        template <typename HeaderT, typename ItemT>
+        struct node_base {
+
+            using node_id_type = fixed_model::node_id_type;
+
+            node_base(page_view_type page, node_id_type self_id, page_handle hdl)
+                : page_(page)
+                , id_(self_id)
+                , hdl_(std::move(hdl))
+            {}
+
+            node_base() = default;
+            node_base(node_base&&) = default;
+            node_base& operator = (node_base&&) = default;
+            node_base(const node_base&) = default;
+            node_base& operator = (const node_base&) = default;
+
+            constexpr static std::size_t capacity_for(std::size_t body_size) noexcept {
+                return body_size / (sizeof(key_type) + sizeof(ItemT));
+            }
+
+            std::size_t capacity() const noexcept {
+                return capacity_for(page_.capacity());
+            }
+
+            std::size_t size() const noexcept {
+                return header()->size.get();
+            }
+
+            bool is_full() const noexcept {
+                return size() >= capacity();
+            }
+
+            bool is_underflow() const noexcept {
+                return size() <= capacity() / 2;
+            }
+
+            double fill_ratio() const noexcept {
+                return static_cast<double>(size()) / static_cast<double>(capacity());
+            }
+
+            bool keys_eq(const key_like_type& a, const key_like_type& b) const noexcept {
+                return !(a.key < b.key) && !(b.key < a.key);
+            }
+
+            node_id_type self() const noexcept {
+                return id_;
+            }
+
+            bool is_valid() const noexcept {
+                return id_ != invalid_node_value;
+            }
+
+            key_out_type get_key(std::size_t pos) const noexcept {
+                return { load<key_type>(key_ptr(pos)) };
+            }
+
+            key_borrow_type borrow_key(std::size_t pos) const noexcept {
+                return { load<key_type>(key_ptr(pos)) };
+            }
+
+            bool can_update_key(std::size_t, const key_like_type&) const noexcept {
+                return true;
+            }
+
+            bool update_key(std::size_t pos, const key_like_type& k) {
+                store(key_ptr(pos), k.key);
+                return check_mark_dirty(true);
+            }
+
+            bool erase(std::size_t pos) {
+                const auto count = size();
+                if (pos >= count) {
+                    return false;
+                }
+                const auto tail = count - pos - 1;
+                std::memmove(key_ptr(pos), key_ptr(pos + 1), tail * sizeof(key_type));
+                std::memmove(item_ptr(pos), item_ptr(pos + 1), tail * sizeof(ItemT));
+                set_size(count - 1);
+                return check_mark_dirty(true);
+            }
+
+            page_view_type get_page() const noexcept {
+                return page_;
+            }
+
+            //protected:
+
+            template <bool UpperBound>
+            std::size_t search(const key_type& key) const noexcept {
+                const auto* keys = key_ptr(0);
+                const auto count = size();
+                if constexpr (simd_search) {
+                    return core::simd::bound<UpperBound, key_type>(keys, count, key);
+                }
+                else {
+                    std::size_t lo = 0;
+                    std::size_t len = count;
+                    while (len > 0) {
+                        const auto half = len / 2;
+                        const auto val = load<key_type>(keys + (lo + half) * sizeof(key_type));
+                        if (UpperBound ? !(key < val) : (val < key)) {
+                            lo += half + 1;
+                            len -= half + 1;
+                        }
+                        else {
+                            len = half;
+                        }
+                    }
+                    return lo;
+                }
+            }
+
+            bool insert_item(std::size_t pos, const key_type& key, const ItemT& item) {
+                const auto count = size();
+                if (count >= capacity() || pos > count) {
+                    return false;
+                }
+                const auto tail = count - pos;
+                std::memmove(key_ptr(pos + 1), key_ptr(pos), tail * sizeof(key_type));
+                std::memmove(item_ptr(pos + 1), item_ptr(pos), tail * sizeof(ItemT));
+                store(key_ptr(pos), key);
+                store(item_ptr(pos), item);
+                set_size(count + 1);
+                return check_mark_dirty(true);
+            }
+
+            ItemT get_item(std::size_t pos) const noexcept {
+                return load<ItemT>(item_ptr(pos));
+            }
+
+            bool set_item(std::size_t pos, const ItemT& item) {
+                store(item_ptr(pos), item);
+                return check_mark_dirty(true);
+            }
+
+            template <typename T>
+            static T load(const core::byte* where) noexcept {
+                T val;
+                std::memcpy(&val, where, sizeof(T));
+                return val;
+            }
+
+            template <typename T>
+            static void store(core::byte* where, const T& val) noexcept {
+                std::memcpy(where, &val, sizeof(T));
+            }
+
+            core::byte* key_ptr(std::size_t pos) const noexcept {
+                return base() + pos * sizeof(key_type);
+            }
+
+            core::byte* item_ptr(std::size_t pos) const noexcept {
+                return base() + capacity() * sizeof(key_type) + pos * sizeof(ItemT);
+            }
+
+            core::byte* base() const noexcept {
+                auto pv = page_;
+                return pv.base_ptr();
+            }
+
+            HeaderT* header() const noexcept {
+                auto pv = page_;
+                return pv.subheader<HeaderT>();
+            }
+
+            void set_size(std::size_t value) noexcept {
+                header()->size = static_cast<core::word_u16::word_type>(value);
+            }
+
+            bool check_mark_dirty(bool ok) {
+                if (ok) {
+                    hdl_.mark_dirty();
+                }
+                return ok;
+            }
+
+            page_view_type page_;
+            node_id_type id_ = invalid_node_value;
+            page_handle hdl_;
+        };
+
+        struct leaf_type : public node_base<page::bpt_fixed_leaf_header, value_type> {
+
+            using base_type = node_base<page::bpt_fixed_leaf_header, value_type>;
+            using base_type::base_type;
+
+            std::size_t key_position(const key_like_type& k) const noexcept {
+                return this->template search<false>(k.key);
+            }
+
+            value_out_type get_value(std::size_t pos) const noexcept {
+                return { this->get_item(pos) };
+            }
+
+            value_borrow_type borrow_value(std::size_t pos) const noexcept {
+                return { this->get_item(pos) };
+            }
+
+            bool can_insert_value(std::size_t, const key_like_type&, const value_in_type&) const noexcept {
+                return !this->is_full();
+            }
+
+            bool can_update_value(std::size_t, const value_in_type&) const noexcept {
+                return true;
+            }
+
+            bool insert_value(std::size_t pos, const key_like_type& k, const value_in_type& v) {
+                return this->insert_item(pos, k.key, v.val);
+            }
+
+            bool update_value(std::size_t pos, const value_in_type& v) {
+                return this->set_item(pos, v.val);
+            }
+
+            void set_next(node_id_type nv) {
+                this->header()->next = nv;
+                this->check_mark_dirty(true);
+            }
+
+            node_id_type get_next() const {
+                return this->header()->next;
+            }
+
+            void set_prev(node_id_type nv) {
+                this->header()->prev = nv;
+                this->check_mark_dirty(true);
+            }
+
+            node_id_type get_prev() const {
+                return this->header()->prev;
+            }
+
+            void set_parent(node_id_type new_value) requires parent_links {
+                this->header()->parent = new_value;
+                this->check_mark_dirty(true);
+            }
+
+            node_id_type get_parent() const requires parent_links {
+                return this->header()->parent;
+            }
+        };
+
+        struct inode_type : public node_base<page::bpt_fixed_inode_header, node_id_type> {
+
+            using base_type = node_base<page::bpt_fixed_inode_header, node_id_type>;
+            using base_type::base_type;
+
+            std::size_t key_position(const key_like_type& k) const noexcept {
+                return this->template search<true>(k.key);
+            }
+
+            node_id_type get_child(std::size_t pos) const {
+                const auto count = this->size();
+                if (pos < count) {
+                    return this->get_item(pos);
+                }
+                else if (pos == count) {
+                    return this->header()->rightmost_child;
+                }
+                return invalid_node_value;
+            }
+
+            bool can_insert_child(std::size_t, const key_like_type&, node_id_type) const noexcept {
+                return !this->is_full();
+            }
+
+            bool can_update_child(std::size_t, node_id_type) const noexcept {
+                return true;
+            }
+
+            bool insert_child(std::size_t pos, const key_like_type& k, node_id_type c) {
+                return this->insert_item(pos, k.key, c);
+            }
+
+            bool update_child(std::size_t pos, node_id_type c) {
+                const auto count = this->size();
+                if (pos < count) {
+                    return this->set_item(pos, c);
+                }
+                else if (pos == count) {
+                    this->header()->rightmost_child = c;
+                    return this->check_mark_dirty(true);
+                }
+                return false;
+            }
+
+            void set_parent(node_id_type new_value) requires parent_links {
+                this->header()->parent = new_value;
+                this->check_mark_dirty(true);
+            }
+
+            node_id_type get_parent() const requires parent_links {
+                return this->header()->parent;
+            }
+
+            void set_next(node_id_type nv) requires inode_links {
+                this->header()->next = nv;
+                this->check_mark_dirty(true);
+            }
+
+            node_id_type get_next() const requires inode_links {
+                return this->header()->next;
+            }
+        };
+
+        static_assert(concepts::INode<inode_type, key_out_type, key_like_type, key_borrow_type>);
+        static_assert(concepts::LeafNode<leaf_type, key_out_type, key_like_type, key_borrow_type,
+                value_out_type, value_in_type, value_borrow_type>);
+
+        struct accessor_type {
+
+            using leaf_type = fixed_model::leaf_type;
+            using inode_type = fixed_model::inode_type;
+
+            accessor_type(buffer_manager_type& mgr, root_manager_type root)
+                : mgr_(&mgr)
+                , root_(std::move(root))
+            {}
+
+            static_assert(page::metadata_size<leaf_metadata_type>() < 1024,
+                    "Leaf metadata too large (>1KB)");
+            static_assert(page::metadata_size<inode_metadata_type>() < 1024,
+                    "INode metadata too large (>1KB)");
+
+            leaf_type create_leaf() {
+                auto new_page = mgr_->allocate();
+                if (new_page.is_valid()) {
+                    auto pv = page_view_type{ new_page.rw_span() };
+                    const auto page_id = new_page.pid();
+                    pv.header().init(leaf_kind_value,
+                        mgr_->page_size(),
+                        page_id,
+                        sizeof(page::bpt_fixed_leaf_header),
+                        page::metadata_size<leaf_metadata_type>());
+                    auto subhdr = pv.subheader<page::bpt_fixed_leaf_header>();
+                    subhdr->init();
+                    subhdr->parent = invalid_node_value;
+                    subhdr->next = invalid_node_value;
+                    subhdr->prev = invalid_node_value;
+
+                    if constexpr (core::concepts::HasInit<leaf_metadata_type>) {
+                        pv.metadata_as<leaf_metadata_type>()->init();
+                    }
+
+                    new_page.mark_dirty();
+                    return { pv, page_id, std::move(new_page) };
+                }
+                return {};
+            }
+
+            inode_type create_inode() {
+                auto new_page = mgr_->allocate();
+                if (new_page.is_valid()) {
+                    auto pv = page_view_type{ new_page.rw_span() };
+                    const auto page_id = new_page.pid();
+                    pv.header().init(inode_kind_value,
+                        mgr_->page_size(),
+                        page_id,
+                        sizeof(page::bpt_fixed_inode_header),
+                        page::metadata_size<inode_metadata_type>());
+                    auto subhdr = pv.subheader<page::bpt_fixed_inode_header>();
+                    subhdr->init();
+                    subhdr->parent = invalid_node_value;
+                    subhdr->next = invalid_node_value;
+
+                    if constexpr (core::concepts::HasInit<inode_metadata_type>) {
+                        pv.metadata_as<inode_metadata_type>()->init();
+                    }
+
+                    new_page.mark_dirty();
+                    return { pv, page_id, std::move(new_page) };
+                }
+                return {};
+            }
+
+            bool destroy(node_id_type id) {
+                mgr_->destroy(id);
+                return true;
+            }
+
+            leaf_type load_leaf(node_id_type id) {
+                if (auto page = load_kind(id, leaf_kind_value); page.is_valid()) {
+                    const auto page_id = page.pid();
+                    auto pv = page_view_type{ page.rw_span() };
+                    return { pv, page_id, std::move(page) };
+                }
+                return {};
+            }
+
+            inode_type load_inode(node_id_type id) {
+                if (auto page = load_kind(id, inode_kind_value); page.is_valid()) {
+                    const auto page_id = page.pid();
+                    auto pv = page_view_type{ page.rw_span() };
+                    return { pv, page_id, std::move(page) };
+                }
+                return {};
+            }
+
+            bool can_merge_leafs(const leaf_type& dst, const leaf_type& src) const {
+                return dst.capacity() >= (dst.size() + src.size());
+            }
+
+            bool can_merge_inodes(const inode_type& dst, const inode_type& src) const {
+                return dst.capacity() >= (1 + dst.size() + src.size());
+            }
+
+            std::tuple<node_id_type, bool> load_root() {
+                const auto value = root_.get_root();
+                const bool exists = root_.has_root() && (value != invalid_node_value);
+                return std::make_tuple(value, exists);
+            }
+
+            void set_root(node_id_type id) {
+                return root_.set_root(id);
+            }
+
+            buffer_manager_type* mgr_ = nullptr;
+            root_manager_type root_{};
+
+        private:
+            page_handle load_kind(node_id_type id, std::uint16_t kind) {
+                if (id == invalid_node_value) {
+                    return {};
+                }
+                auto page = mgr_->fetch(id);
+                if (page.is_valid()) {
+                    auto pv = page_view_type{ page.rw_span() };
+                    if (pv.header().kind.get() == kind) {
+                        return page;
+                    }
+                }
+                return {};
+            }
+        };
+
+        static_assert(concepts::NodeAccessor<accessor_type, node_id_type, inode_type, leaf_type>);
+
+        fixed_model(buffer_manager_type& mgr, root_manager_type root)
+            : accessor_(mgr, std::move(root))
+        {}
+
+        fixed_model(buffer_manager_type& mgr)
+            : fixed_model(mgr, root_manager_type{})
+        {}
+
+        static key_like_type key_out_as_like(key_out_type kout) {
+            return { kout.key };
+        }
+
+        static key_like_type key_borrow_as_like(const key_borrow_type& kbor) {
+            return { kbor.key };
+        }
+
+        static value_in_type value_out_as_in(value_out_type vout) {
+            return { vout.val };
+        }
+
+        static value_in_type value_borrow_as_in(const value_borrow_type& vbor) {
+            return { vbor.val };
+        }
+
+        static bool key_less(const key_like_type& a, const key_like_type& b) {
+            return less_type{}(a.key, b.key);
+        }
+
+        bool is_valid_id(node_id_type id) {
+            return (id != invalid_node_value) && (accessor_.mgr_->valid_id(id));
+        }
+
+        // see concepts::ModelSharedNodes
+        bool shares_nodes_with(const fixed_model& other) const noexcept {
+            return accessor_.mgr_ == other.accessor_.mgr_;
+        }
+
+        bool is_leaf_id(node_id_type id) {
+            auto p = accessor_.mgr_->fetch(id);
+            if (p.is_valid()) {
+                return reinterpret_cast<const page::page_header*>(p.ro_span().data())->kind
+                    == static_cast<std::uint16_t>(leaf_kind_value);
+            }
+            return false;
+        }
+
+        static node_id_type get_invalid_node_id() noexcept {
+            return invalid_node_value;
+        }
+
+        accessor_type& get_accessor() noexcept {
+            return accessor_;
+        }
+
+        const accessor_type& get_accessor() const noexcept {
+            return accessor_;
+        }
+
+    private:
+        accessor_type accessor_;
+    };
+}
@@ -13,6 +13,7 @@
 #include <ranges>
 #include <algorithm>
 #include <functional>
+#include <cstring>
 
 #include "fulla/core/debug.hpp"
 #include "fulla/core/concepts.hpp"
@@ -23,6 +24,7 @@
 #include "fulla/page/page_view.hpp"
 #include "fulla/page/bpt_inode.hpp"
 #include "fulla/page/bpt_leaf.hpp"
+#include "fulla/page/bpt_heads.hpp"
 #include "fulla/page/bpt_root.hpp"
 #include "fulla/page/metadata.hpp"
 
@@ -32,6 +34,7 @@
 #include "fulla/page/ranges.hpp"
 
 #include "fulla/page_allocator/concepts.hpp"
+#include "fulla/long_store/handle.hpp"
 
 namespace fulla::bpt::paged {
 
@@ -47,6 +50,49 @@ namespace fulla::bpt::paged {
             byte_view key;
         };
 
+        // Keys of prefix_keys models are put back together from the page prefix and the
+        // slot, so the result owns the bytes and `key` views them.
+        struct owning_key_out_type {
+            owning_key_out_type() = default;
+
+            explicit owning_key_out_type(byte_buffer bytes)
+                : buf(std::move(bytes))
+                , key(buf)
+            {}
+
+            owning_key_out_type(const owning_key_out_type& other)
+                : buf(other.buf)
+                , key(buf)
+            {}
+
+            owning_key_out_type(owning_key_out_type&& other) noexcept
+                : buf(std::move(other.buf))
+                , key(buf)
+            {
+                other.key = {};
+            }
+
+            owning_key_out_type& operator = (const owning_key_out_type& other) {
+                if (this != &other) {
+                    buf = other.buf;
+                    key = buf;
+                }
+                return *this;
+            }
+
+            owning_key_out_type& operator = (owning_key_out_type&& other) noexcept {
+                if (this != &other) {
+                    buf = std::move(other.buf);
+                    key = buf;
+                    other.key = {};
+                }
+                return *this;
+            }
+
+            byte_buffer buf;
+            byte_view key;
+        };
+
         struct key_borrow_type {
             byte_buffer key;
         };
@@ -63,6 +109,19 @@ namespace fulla::bpt::paged {
             byte_buffer val;
         };
 
+        // Values of models with out-of-line storage (overflow_bpt_descriptor). With `external`
+        // set, `val` is a page::bpt_leaf_external_value the model has already stored; that is
+        // how the tree moves such values between leaves without copying the chain.
+        struct overflow_value_in_type {
+            byte_view val;
+            bool external = false;
+        };
+
+        struct overflow_value_borrow_type {
+            byte_buffer val;
+            bool external = false;
+        };
+
         using slot_directory_type = slots::variadic_directory_view<>;
         using page_view_type = page::page_view<slot_directory_type>;
         using cpage_view_type = page::const_page_view<slot_directory_type>;
@@ -105,6 +164,90 @@ namespace fulla::bpt::paged {
         constexpr static const std::uint16_t inode_kind_value = 2;
     };
 
+    // Nodes don't keep the parent pid in their page header; the tree tracks parents
+    // in memory, so moving children between inodes no longer dirties the child pages.
+    struct parentless_bpt_descriptor : default_bpt_descriptor {
+        constexpr static const bool parent_links = false;
+    };
+
+    // Inode slots carry the number of elements under each child (page::bpt_inode_counted_slot),
+    // which gives the tree rank / nth / count in O(log n).
+    struct counted_bpt_descriptor : default_bpt_descriptor {
+        constexpr static const bool child_counts = true;
+    };
+
+    // Leaf values longer than settings::leaf_value_overflow, or too long for a leaf slot,
+    // go to a long_store chain and the leaf keeps a page::bpt_leaf_external_value for them.
+    // Leaves stay dense whatever the value sizes are.
+    struct overflow_bpt_descriptor : default_bpt_descriptor {
+        constexpr static const bool value_overflow = true;
+    };
+
+    // Inodes keep a right-link to the next inode of the same level (B-link tree) and
+    // lookups move right along the links; the inode subheader grows to
+    // page::bpt_inode_wide_header for it.
+    struct blink_bpt_descriptor : default_bpt_descriptor {
+        constexpr static const bool inode_links = true;
+    };
+
+    // Nodes keep a page prefix (page::bpt_key_prefix, settings::key_prefix_size) and every
+    // key stores only the bytes past the part it shares with it. Keys with long common
+    // heads (paths, composite keys) take less room, so nodes fit more of them. Needs a
+    // byte-ordered KeyLessT; get_key() returns owning keys.
+    struct prefix_bpt_descriptor : default_bpt_descriptor {
+        constexpr static const bool prefix_keys = true;
+    };
+
+    template <typename Descriptor>
+    constexpr bool descriptor_parent_links() {
+        if constexpr (requires { { Descriptor::parent_links } -> std::convertible_to<bool>; }) {
+            return Descriptor::parent_links;
+        }
+        else {
+            return true;
+        }
+    }
+
+    template <typename Descriptor>
+    constexpr bool descriptor_child_counts() {
+        if constexpr (requires { { Descriptor::child_counts } -> std::convertible_to<bool>; }) {
+            return Descriptor::child_counts;
+        }
+        else {
+            return false;
+        }
+    }
+
+    template <typename Descriptor>
+    constexpr bool descriptor_value_overflow() {
+        if constexpr (requires { { Descriptor::value_overflow } -> std::convertible_to<bool>; }) {
+            return Descriptor::value_overflow;
+        }
+        else {
+            return false;
+        }
+    }
+
+    template <typename Descriptor>
+    constexpr bool descriptor_inode_links() {
+        if constexpr (requires { { Descriptor::inode_links } -> std::convertible_to<bool>; }) {
+            return Descriptor::inode_links;
+        }
+        else {
+            return false;
+        }
+    }
+
+    template <typename Descriptor>
+    constexpr bool descriptor_prefix_keys() {
+        if constexpr (requires { { Descriptor::prefix_keys } -> std::convertible_to<bool>; }) {
+            return Descriptor::prefix_keys;
+        }
+        else {
+            return false;
+        }
+    }
+
     template <page_allocator::concepts::PageAllocator PageAllocatorT,
         ModelKeyLessConcept KeyLessT = page::record_less,
         core::concepts::RootManager RootManagerT = memory_root_manager<typename PageAllocatorT::pid_type>,
@@ -116,6 +259,14 @@ namespace fulla::bpt::paged {
         constexpr static const std::uint16_t inode_kind_value = Descriptor::inode_kind_value;
         using leaf_metadata_type = Descriptor::leaf_metadata_type;
         using inode_metadata_type = Descriptor::inode_metadata_type;
+        constexpr static const bool parent_links = descriptor_parent_links<Descriptor>();
+        constexpr static const bool child_counts = descriptor_child_counts<Descriptor>();
+        constexpr static const bool value_overflow = descriptor_value_overflow<Descriptor>();
+        constexpr static const bool prefix_keys = descriptor_prefix_keys<Descriptor>();
+        constexpr static const bool inode_links = descriptor_inode_links<Descriptor>();
+        using inode_slot_type = std::conditional_t<child_counts, page::bpt_inode_counted_slot, page::bpt_inode_slot>;
+        using inode_header_type = std::conditional_t<child_counts || inode_links,
+            page::bpt_inode_wide_header, page::bpt_inode_header>;
 
         using root_manager_type = RootManagerT;
         using buffer_manager_type = PageAllocatorT;
@@ -126,6 +277,8 @@ namespace fulla::bpt::paged {
         using cpage_view_type = model_common::cpage_view_type;
 
         using less_type = KeyLessT;
+        static_assert(!prefix_keys || page::BytewiseKeyLess<less_type>,
+            "prefix_keys needs a byte-ordered KeyLessT");
 
         using node_id_type = pid_type;
         constexpr static const node_id_type invalid_node_value = std::numeric_limits<node_id_type>::max();
@@ -136,16 +289,66 @@ namespace fulla::bpt::paged {
         constexpr static const std::size_t maximum_leaf_slot_size = 200;
         constexpr static const std::size_t minumum_leaf_slot_size = 5;
 
+        using long_store_type = long_store::handle<buffer_manager_type>;
+
+        // A value read from an overflow leaf. An inline value is in `val`. An out-of-line one
+        // leaves `val` empty; load() and read() fetch it from its chain on demand.
+        struct overflow_value_out_type {
+            byte_view val;
+            // the stored page::bpt_leaf_external_value of an out-of-line value
+            byte_view ref;
+            buffer_manager_type* mgr = nullptr;
+
+            bool is_external() const noexcept {
+                return !ref.empty();
+            }
+
+            std::size_t size() const noexcept {
+                return is_external() ? static_cast<std::size_t>(record()->size.get()) : val.size();
+            }
+
+            byte_buffer load() const {
+                byte_buffer result(size());
+                read(0, result);
+                return result;
+            }
+
+            // Copies up to out.size() bytes starting at `offset`; returns the number copied.
+            std::size_t read(std::size_t offset, core::byte_span out) const {
+                const auto total = size();
+                if (offset >= total) {
+                    return 0;
+                }
+                const auto len = std::min(out.size(), total - offset);
+                if (!is_external()) {
+                    std::memcpy(out.data(), val.data() + offset, len);
+                    return len;
+                }
+                long_store_type chain(*mgr, record()->header.get());
+                chain.seekg(offset);
+                return chain.read(out.data(), len);
+            }
+
+        private:
+            const page::bpt_leaf_external_value* record() const noexcept {
+                return reinterpret_cast<const page::bpt_leaf_external_value*>(ref.data());
+            }
+        };
+
         using key_like_type = model_common::key_like_type;
-        using key_out_type = model_common::key_out_type;
+        using key_out_type = std::conditional_t<prefix_keys,
+            model_common::owning_key_out_type, model_common::key_out_type>;
         using key_borrow_type = model_common::key_borrow_type;
-        using value_in_type = model_common::value_in_type;
-        using value_out_type = model_common::value_out_type;
-        using value_borrow_type = model_common::value_borrow_type;
+        using value_in_type = std::conditional_t<value_overflow,
+            model_common::overflow_value_in_type, model_common::value_in_type>;
+        using value_out_type = std::conditional_t<value_overflow,
+            overflow_value_out_type, model_common::value_out_type>;
+        using value_borrow_type = std::conditional_t<value_overflow,
+            model_common::overflow_value_borrow_type, model_common::value_borrow_type>;
 
         struct inode_key_extractor {
             byte_view operator ()(byte_view value) const noexcept {
-                const auto* slot_hdr = reinterpret_cast<const page::bpt_inode_slot*>(value.data());
+                const auto* slot_hdr = reinterpret_cast<const inode_slot_type*>(value.data());
                 return { value.begin() + slot_hdr->key_offset(), value.end() };
             }
         };
@@ -211,6 +414,12 @@ namespace fulla::bpt::paged {
                 return slots.stored_size() < slots.available();
             }
 
+            double fill_ratio() const noexcept {
+                const auto slots = this->get_slots();
+                const auto total = slots.maximum_slot_size() + sizeof(typename slot_directory_type::slot_type);
+                return 1.0 - static_cast<double>(slots.available_after_compact()) / static_cast<double>(total);
+            }
+
             bool keys_eq(key_like_type a, key_like_type b) const noexcept {
                 const auto key_cmp = make_key_less();
                 return std::is_eq(key_cmp.compare(a.key, b.key));
@@ -225,15 +434,20 @@ namespace fulla::bpt::paged {
                 const auto old_slot_value = slots.get_slot(pos);
                 const auto old_key_value = extract_key(old_slot_value);
                 const auto old_size_without_key = old_slot_value.size() - old_key_value.size();
-                return slots.can_update(pos, old_size_without_key + k.key.size());
+                return slots.can_update(pos, old_size_without_key + stored_key_size(k.key));
             }
 
             key_out_type get_key(std::size_t pos) const {
                 auto pv = get_page();
                 auto slots = pv.get_slots_dir();
                 if (pos < slots.size()) {
-                    auto res = key_out_type{ extract_key(slots.get_slot(pos)) };
-                    return res;
+                    if constexpr (prefix_keys) {
+                        return key_out_type{ load_key(extract_key(slots.get_slot(pos))) };
+                    }
+                    else {
+                        auto res = key_out_type{ extract_key(slots.get_slot(pos)) };
+                        return res;
+                    }
                 }
                 return {};
             }
@@ -243,8 +457,7 @@ namespace fulla::bpt::paged {
                 auto slots = get_slots();
 
                 if (pos < slots.size()) {
-                    auto key_result = extract_key(slots.get_slot(pos));
-                    key_borrow_type result{ .key = byte_buffer {key_result.begin(), key_result.end()} };
+                    key_borrow_type result{ .key = load_key(extract_key(slots.get_slot(pos))) };
                     return result;
                 }
                 return {};
@@ -284,6 +497,250 @@ namespace fulla::bpt::paged {
 
             virtual byte_view extract_key(byte_view val) const = 0;
 
+            // The page prefix of prefix_keys models, nullptr for the others.
+            virtual page::bpt_key_prefix* key_prefix() const = 0;
+
+            // Bytes the slot keeps for `key`.
+            std::size_t stored_key_size(byte_view key) const {
+                if constexpr (prefix_keys) {
+                    return 1 + key.size() - key_prefix()->shared(key);
+                }
+                else {
+                    return key.size();
+                }
+            }
+
+            // Writes the stored_key_size(key) bytes the slot keeps for `key` to `out`.
+            void store_key(byte_view key, core::byte* out) const {
+                std::size_t shared = 0;
+                if constexpr (prefix_keys) {
+                    shared = key_prefix()->shared(key);
+                    *out++ = static_cast<core::byte>(shared);
+                }
+                if (key.size() > shared) {
+                    std::memcpy(out, key.data() + shared, key.size() - shared);
+                }
+            }
+
+            // The key kept in the slot as `stored`.
+            byte_buffer load_key(byte_view stored) const {
+                if constexpr (prefix_keys) {
+                    const auto shared = static_cast<std::size_t>(stored[0]);
+                    const auto prefix = key_prefix()->view();
+                    byte_buffer result(prefix.begin(), prefix.begin() + shared);
+                    result.insert(result.end(), stored.begin() + 1, stored.end());
+                    return result;
+                }
+                else {
+                    return byte_buffer(stored.begin(), stored.end());
+                }
+            }
+
+            // A page with no keys takes its prefix from the first key stored into it.
+            void reset_prefix(byte_view key) {
+                if constexpr (prefix_keys) {
+                    if (size() == 0) {
+                        key_prefix()->assign(key);
+                    }
+                }
+            }
+
+            // Order of the stored key against `key`, which shares `shared` leading bytes with
+            // the page prefix. Both begin with the first min(n, shared) bytes of the prefix,
+            // n being the count the stored key shares; past them a key with n <= shared is
+            // compared by its rest, any other one differs from `key` at byte `shared`.
+            std::strong_ordering compare_stored(byte_view stored, byte_view key, std::size_t shared) const {
+                const auto n = static_cast<std::size_t>(stored[0]);
+                if (n <= shared) {
+                    return page::bytewise_less{}.compare(stored.subspan(1), key.subspan(n));
+                }
+                if (key.size() == shared) {
+                    return std::strong_ordering::greater;
+                }
+                const auto prefix = key_prefix()->view();
+                return static_cast<std::uint8_t>(prefix[shared]) <=> static_cast<std::uint8_t>(key[shared]);
+            }
+
+            // Binary search over the keys of a prefix_keys page; the probe is matched
+            // against the page prefix once.
+            template <bool UpperBound>
+            std::size_t stored_search(byte_view key) const {
+                const auto slots = get_slots();
+                const auto shared = key_prefix()->shared(key);
+                std::size_t lo = 0;
+                std::size_t hi = slots.size();
+                while (lo < hi) {
+                    const auto mid = lo + (hi - lo) / 2;
+                    const auto ord = compare_stored(extract_key(slots.get_slot(mid)), key, shared);
+                    const bool go_right = UpperBound ? std::is_lteq(ord) : std::is_lt(ord);
+                    if (go_right) {
+                        lo = mid + 1;
+                    }
+                    else {
+                        hi = mid;
+                    }
+                }
+                return lo;
+            }
+
+            // Binary search for byte-ordered keys. The first and the last key bound the page,
+            // so their common prefix is shared by every key: the probe is checked against it once
+            // and then only the remaining suffixes are compared.
+            template <bool UpperBound>
+            std::size_t prefix_search(byte_view key) const {
+                const auto slots = get_slots();
+                const std::size_t count = slots.size();
+                if (count == 0) {
+                    return 0;
+                }
+                const auto first = extract_key(slots.get_slot(0));
+                const auto last = extract_key(slots.get_slot(count - 1));
+                const auto prefix = static_cast<std::size_t>(std::ranges::mismatch(first, last).in1 - first.begin());
+
+                const auto head = std::min(prefix, key.size());
+                const int head_cmp = (head > 0) ? std::memcmp(key.data(), first.data(), head) : 0;
+                if (head_cmp < 0 || (head_cmp == 0 && key.size() < prefix)) {
+                    return 0;
+                }
+                if (head_cmp > 0) {
+                    return count;
+                }
+
+                return suffix_search<UpperBound>(key.subspan(prefix), prefix, 0, count);
+            }
+
+            // Binary search over [lo, hi), comparing the keys past the first `prefix` bytes.
+            template <bool UpperBound>
+            std::size_t suffix_search(byte_view suffix, std::size_t prefix, std::size_t lo, std::size_t hi) const {
+                const auto slots = get_slots();
+                const auto suffix_cmp = page::bytewise_less{};
+                while (lo < hi) {
+                    const auto mid = lo + (hi - lo) / 2;
+                    const auto mid_suffix = extract_key(slots.get_slot(mid)).subspan(prefix);
+                    const auto ord = suffix_cmp.compare(mid_suffix, suffix);
+                    const bool go_right = UpperBound ? std::is_lteq(ord) : std::is_lt(ord);
+                    if (go_right) {
+                        lo = mid + 1;
+                    }
+                    else {
+                        hi = mid;
+                    }
+                }
+                return lo;
+            }
+
+            // Optional blocks the page was created with follow the node subheader SubHdrT,
+            // in this order: key heads, key fingerprints. Each one starts with its tag.
+            // Pages of prefix_keys models have the key prefix there instead.
+            template <typename SubHdrT, typename BlockT>
+            BlockT* subheader_block() const {
+                auto pv = get_page();
+                const std::size_t end = pv.header().subhdr_size.get();
+                auto* base = reinterpret_cast<core::byte*>(pv.subheader<SubHdrT>());
+                const auto tagged = [&](std::size_t off, std::uint16_t tag) {
+                    return (off + sizeof(core::word_u16) <= end)
+                        && (reinterpret_cast<const core::word_u16*>(base + off)->get() == tag);
+                };
+                std::size_t at = sizeof(SubHdrT);
+                if constexpr (std::same_as<BlockT, page::bpt_key_fingerprints>) {
+                    if (tagged(at, page::bpt_key_heads::tag_value)) {
+                        at += reinterpret_cast<const page::bpt_key_heads*>(base + at)->block_size();
+                    }
+                }
+                if ((at + sizeof(BlockT) <= end) && tagged(at, BlockT::tag_value)) {
+                    return reinterpret_cast<BlockT*>(base + at);
+                }
+                return nullptr;
+            }
+
+            // The heads split the keys into three runs: below the probe, sharing its head
+            // and above it. Only the middle run is compared by the full key.
+            template <bool UpperBound>
+            std::size_t heads_search(const page::bpt_key_heads& idx, byte_view key) const {
+                const auto slots = get_slots();
+                const std::size_t count = idx.count.get();
+                const std::size_t prefix = idx.prefix_len.get();
+                if (count == 0) {
+                    return 0;
+                }
+                const auto first = extract_key(slots.get_slot(0));
+                const auto head = std::min(prefix, key.size());
+                const int head_cmp = (head > 0) ? std::memcmp(key.data(), first.data(), head) : 0;
+                if (head_cmp < 0 || (head_cmp == 0 && key.size() < prefix)) {
+                    return 0;
+                }
+                if (head_cmp > 0) {
+                    return count;
+                }
+                const auto suffix = key.subspan(prefix);
+                const auto probe = page::bpt_key_heads::make_head(suffix);
+                const auto lo = idx.count_below<false>(probe);
+                const auto hi = idx.count_below<true>(probe);
+                return suffix_search<UpperBound>(suffix, prefix, lo, hi);
+            }
+
+            // Recomputes the prefix and every head; the index is dropped (count = 0) while
+            // the page holds more keys than it fits.
+            void rebuild_heads(page::bpt_key_heads* idx) {
+                if constexpr (page::BytewiseKeyLess<less_type>) {
+                    if (idx == nullptr) {
+                        return;
+                    }
+                    const auto slots = get_slots();
+                    const std::size_t count = slots.size();
+                    if (count == 0 || count > idx->capacity.get()) {
+                        idx->count = 0;
+                        return;
+                    }
+                    const auto first = extract_key(slots.get_slot(0));
+                    const auto last = extract_key(slots.get_slot(count - 1));
+                    const auto prefix = static_cast<std::size_t>(std::ranges::mismatch(first, last).in1 - first.begin());
+                    idx->prefix_len = static_cast<core::word_u16::word_type>(prefix);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        const auto key = extract_key(slots.get_slot(i));
+                        idx->set_head(i, page::bpt_key_heads::make_head(key.subspan(prefix)));
+                    }
+                    idx->seal(count);
+                }
+            }
+
+            // `key` was inserted at `pos`. While it shares the page prefix only its head is
+            // added; a shorter common prefix changes every head.
+            void heads_inserted(page::bpt_key_heads* idx, std::size_t pos, byte_view key) {
+                if constexpr (page::BytewiseKeyLess<less_type>) {
+                    if (idx == nullptr) {
+                        return;
+                    }
+                    const auto slots = get_slots();
+                    const std::size_t count = slots.size();
+                    const std::size_t prefix = idx->prefix_len.get();
+                    if ((count > 1) && (idx->count.get() == count - 1) && (key.size() >= prefix)) {
+                        const auto other = extract_key(slots.get_slot(pos == 0 ? 1 : 0));
+                        if ((prefix == 0 || std::memcmp(key.data(), other.data(), prefix) == 0)
+                            && idx->insert_head(pos, page::bpt_key_heads::make_head(key.subspan(prefix)))) {
+                            idx->seal(count, pos);
+                            return;
+                        }
+                    }
+                    rebuild_heads(idx);
+                }
+            }
+
+            // The remaining keys still share the prefix, so the heads only shift.
+            void heads_erased(page::bpt_key_heads* idx, std::size_t pos) {
+                if constexpr (page::BytewiseKeyLess<less_type>) {
+                    if (idx == nullptr) {
+                        return;
+                    }
+                    const std::size_t count = size();
+                    if ((count > 0) && (idx->count.get() == count + 1) && idx->erase_head(pos)) {
+                        idx->seal(count, pos);
+                        return;
+                    }
+                    rebuild_heads(idx);
+                }
+            }
+
             page_view_type page_;
             node_id_type id_ = invalid_node_value;
             std::size_t minimum_len = 0;
@@ -312,6 +769,15 @@ namespace fulla::bpt::paged {
             }
 
             std::size_t key_position(key_like_type k) const {
+                if constexpr (prefix_keys) {
+                    return this->template stored_search<false>(k.key);
+                }
+                else if constexpr (page::BytewiseKeyLess<less_type>) {
+                    if (const auto* idx = heads_index(); idx && idx->count.get() == this->size()) {
+                        return this->template heads_search<false>(*idx, k.key);
+                    }
+                    return this->template prefix_search<false>(k.key);
+                }
                 auto pv = this->get_page();
                 auto slots = pv.get_slots_dir();
                 auto slots_view = slots.view();
@@ -323,12 +789,37 @@ namespace fulla::bpt::paged {
                 return std::distance(slots_view.begin(), it);
             }
 
+            // Exact match: the position of `k`, or size() if the leaf doesn't hold it. With
+            // fingerprints only the keys whose fingerprint matches are compared.
+            std::size_t find_key(key_like_type k) const {
+                const auto count = this->size();
+                if constexpr (page::BytewiseKeyLess<less_type>) {
+                    if (const auto* fps = fingerprints(); fps && fps->count.get() == count) {
+                        const auto slots = this->get_slots();
+                        std::size_t result = count;
+                        core::simd::find_byte(fps->prints(), count, page::bpt_key_fingerprints::make_fingerprint(k.key),
+                            [&](std::size_t pos) {
+                                if (std::ranges::equal(this->extract_key(slots.get_slot(pos)), k.key)) {
+                                    result = pos;
+                                    return true;
+                                }
+                                return false;
+                            });
+                        return result;
+                    }
+                }
+                const auto pos = key_position(k);
+                return ((pos < count) && this->keys_eq(key_like_type{ this->get_key(pos).key }, k)) ? pos : count;
+            }
+
             bool update_key(std::size_t pos, key_like_type k) {
                 auto slots = this->get_slots();
                 leaf_value_extractor lve;
                 auto old_slot = slots.get_slot(pos);
                 auto old_value = lve(old_slot);
-                auto new_full_len = sizeof(page::bpt_leaf_slot) + k.key.size() + old_value.size();
+                const bool external = reinterpret_cast<const page::bpt_leaf_slot*>(old_slot.data())->is_external();
+                const auto key_len = this->stored_key_size(k.key);
+                auto new_full_len = sizeof(page::bpt_leaf_slot) + key_len + old_value.size();
 
                 if (slots.can_update(pos, new_full_len)) {
                     if (!this->check_length(new_full_len)) {
@@ -337,15 +828,18 @@ namespace fulla::bpt::paged {
                     }
                     byte_buffer new_value(new_full_len);
                     auto* slot_hdr = reinterpret_cast<page::bpt_leaf_slot*>(new_value.data());
-                    slot_hdr->update(k.key.size());
+                    slot_hdr->update(key_len);
+                    slot_hdr->set_external(external);
 
-                    std::memcpy(new_value.data() + slot_hdr->key_offset(), k.key.data(), k.key.size());
+                    this->store_key(k.key, new_value.data() + slot_hdr->key_offset());
                     std::memcpy(new_value.data() + slot_hdr->value_offset(), old_value.data(), old_value.size());
 
                     if (!slots.update(pos, { new_value })) {
                         DB_ASSERT(false, "something went wrong");
                         return false;
                     }
+                    this->rebuild_heads(heads_index());
+                    rebuild_prints(fingerprints());
                     return this->check_mark_dirty(true);
                 }
                 DB_ASSERT(false, "something went wrong");
@@ -354,18 +848,27 @@ namespace fulla::bpt::paged {
 
             bool insert_value(std::size_t pos, key_like_type k, value_in_type v) {
                 auto slots = this->get_slots();
-                auto new_full_len = sizeof(page::bpt_leaf_slot) + k.key.size() + v.val.size();
+                this->reset_prefix(k.key);
+                const auto key_len = this->stored_key_size(k.key);
+                const bool external = goes_external(key_len, v);
+                auto new_full_len = stored_length(key_len, v);
                 if (!this->check_length(new_full_len)) {
                     DB_ASSERT(false, "maximum_leaf_slot_size reached");
                     return false;
                 }
 
+                // the slot first: a chain written for a slot that can't be reserved would leak
                 if (slots.reserve(pos, new_full_len)) {
+                    page::bpt_leaf_external_value record;
+                    const auto value = store_value(key_len, v, record);
                     auto data = slots.get_slot(pos);
                     auto hdr = reinterpret_cast<page::bpt_leaf_slot*>(data.data());
-                    hdr->update(k.key.size());
-                    std::memcpy(data.data() + hdr->key_offset(), k.key.data(), k.key.size());
-                    std::memcpy(data.data() + hdr->value_offset(), v.val.data(), v.val.size());
+                    hdr->update(key_len);
+                    hdr->set_external(external);
+                    this->store_key(k.key, data.data() + hdr->key_offset());
+                    std::memcpy(data.data() + hdr->value_offset(), value.data(), value.size());
+                    this->heads_inserted(heads_index(), pos, k.key);
+                    prints_inserted(fingerprints(), pos, k.key);
                     return this->check_mark_dirty(true);
                 }
                 DB_ASSERT(false, "something went wrong");
@@ -375,23 +878,33 @@ namespace fulla::bpt::paged {
             bool update_value(std::size_t pos, value_in_type v) {
                 auto slots = this->get_slots();
                 const auto old_data = slots.get_slot(pos);
-                const auto old_value = leaf_value_extractor{}(old_data);
                 const auto old_key = leaf_key_extractor{}(old_data);
-                const auto new_size = sizeof(page::bpt_leaf_slot) + old_key.size() + v.val.size();
+                const bool external = goes_external(old_key.size(), v);
+                const auto new_size = stored_length(old_key.size(), v);
                 if (!this->check_length(new_size)) {
                     DB_ASSERT(false, "something went wrong");
                     return false;
                 }
                 if (slots.can_update(pos, new_size)) {
+                    const auto old_chain = external_chain(old_data);
+                    page::bpt_leaf_external_value record;
+                    const auto value = store_value(old_key.size(), v, record);
                     byte_buffer new_data(new_size);
                     auto new_hdr = reinterpret_cast<page::bpt_leaf_slot*>(new_data.data());
                     new_hdr->update(old_key.size());
+                    new_hdr->set_external(external);
                     std::memcpy(new_data.data() + new_hdr->key_offset(), old_key.data(), old_key.size());
-                    std::memcpy(new_data.data() + new_hdr->value_offset(), v.val.data(), v.val.size());
+                    std::memcpy(new_data.data() + new_hdr->value_offset(), value.data(), value.size());
                     if (!slots.update(pos, { new_data })) {
                         DB_ASSERT(false, "something went wrong");
+                        if constexpr (value_overflow) {
+                            if (external && !v.external) {
+                                drop_chain(record.header.get());
+                            }
+                        }
                         return false;
                     }
+                    drop_chain(old_chain);
                     return this->check_mark_dirty(true);
                 }
                 DB_ASSERT(false, "something went wrong");
@@ -400,7 +913,7 @@ namespace fulla::bpt::paged {
 
             bool can_insert_value(std::size_t, key_like_type k, value_in_type v) {
                 const auto slots = this->get_slots();
-                const auto new_full_len = sizeof(page::bpt_leaf_slot) + k.key.size() + v.val.size();
+                const auto new_full_len = stored_length(this->stored_key_size(k.key), v);
                 [[maybe_unused]] const bool size_ok = this->check_length(new_full_len);
                 DB_ASSERT(size_ok, "Something went wrong");
                 return slots.can_insert(new_full_len);
@@ -410,7 +923,7 @@ namespace fulla::bpt::paged {
                 const auto slots = this->get_slots();
                 const auto old_value = slots.get_slot(pos);
                 auto k = leaf_key_extractor{}(old_value);
-                const auto new_full_len = sizeof(page::bpt_leaf_slot) + k.size() + v.val.size();
+                const auto new_full_len = stored_length(k.size(), v);
                 [[maybe_unused]] const bool size_ok = this->check_length(new_full_len);
                 DB_ASSERT(size_ok, "Something went wrong");
                 return slots.can_update(pos, new_full_len);
@@ -420,7 +933,16 @@ namespace fulla::bpt::paged {
                 auto slots = this->get_slots();
                 if (pos < slots.size()) {
                     leaf_value_extractor lve;
-                    return { lve(slots.get_slot(pos)) };
+                    const auto slot = slots.get_slot(pos);
+                    if constexpr (value_overflow) {
+                        if (reinterpret_cast<const page::bpt_leaf_slot*>(slot.data())->is_external()) {
+                            return { .val = {}, .ref = lve(slot), .mgr = overflow_mgr_ };
+                        }
+                        return { .val = lve(slot), .ref = {}, .mgr = overflow_mgr_ };
+                    }
+                    else {
+                        return { lve(slot) };
+                    }
                 }
                 return {};
             }
@@ -430,13 +952,26 @@ namespace fulla::bpt::paged {
                 if (pos < slots.size()) {
                     leaf_value_extractor lve;
                     value_borrow_type res;
-                    const auto value = lve(slots.get_slot(pos));
+                    const auto slot = slots.get_slot(pos);
+                    const auto value = lve(slot);
                     res.val.insert(res.val.end(), value.begin(), value.end());
+                    if constexpr (value_overflow) {
+                        res.external = reinterpret_cast<const page::bpt_leaf_slot*>(slot.data())->is_external();
+                    }
                     return res;
                 }
                 return {};
             }
 
+            // Frees the chain of an out-of-line value. The tree calls it before it erases
+            // an element for good; moving elements between leaves keeps the chain.
+            void release_value(std::size_t pos) requires value_overflow {
+                auto slots = this->get_slots();
+                if (pos < slots.size()) {
+                    drop_chain(external_chain(slots.get_slot(pos)));
+                }
+            }
+
             void set_next(node_id_type nv) {
                 auto pv = this->get_page();
                 auto hdr = pv.subheader<page::bpt_leaf_header>();
@@ -463,19 +998,145 @@ namespace fulla::bpt::paged {
                 return hdr->prev;
             }
 
-            void set_parent(node_id_type new_value) {
+            void set_parent(node_id_type new_value) requires parent_links {
                 page_view_type pv = this->get_page();
                 auto* inode_hdr = pv.subheader<page::bpt_leaf_header>();
                 inode_hdr->parent = new_value;
                 this->check_mark_dirty(true);
             }
 
-            node_id_type get_parent() const {
+            node_id_type get_parent() const requires parent_links {
                 page_view_type pv = this->get_page();
                 auto* inode_hdr = pv.subheader<page::bpt_leaf_header>();
                 return inode_hdr->parent;
             }
 
+            bool erase(std::size_t pos) {
+                if (node_base::erase(pos)) {
+                    this->heads_erased(heads_index(), pos);
+                    prints_erased(fingerprints(), pos);
+                    return true;
+                }
+                return false;
+            }
+
+            page::bpt_key_heads* heads_index() const {
+                return this->template subheader_block<page::bpt_leaf_header, page::bpt_key_heads>();
+            }
+
+            virtual page::bpt_key_prefix* key_prefix() const {
+                if constexpr (prefix_keys) {
+                    return this->template subheader_block<page::bpt_leaf_header, page::bpt_key_prefix>();
+                }
+                else {
+                    return nullptr;
+                }
+            }
+
+            page::bpt_key_fingerprints* fingerprints() const {
+                return this->template subheader_block<page::bpt_leaf_header, page::bpt_key_fingerprints>();
+            }
+
+            // Rehashes every key; the block is dropped (count = 0) while the page holds more
+            // keys than it fits.
+            void rebuild_prints(page::bpt_key_fingerprints* fps) {
+                if (fps == nullptr) {
+                    return;
+                }
+                const auto slots = this->get_slots();
+                const std::size_t count = slots.size();
+                if (count > fps->capacity.get()) {
+                    fps->count = 0;
+                    return;
+                }
+                for (std::size_t i = 0; i < count; ++i) {
+                    fps->set_print(i, page::bpt_key_fingerprints::make_fingerprint(this->extract_key(slots.get_slot(i))));
+                }
+                fps->count = static_cast<core::word_u16::word_type>(count);
+            }
+
+            void prints_inserted(page::bpt_key_fingerprints* fps, std::size_t pos, byte_view key) {
+                if (fps == nullptr) {
+                    return;
+                }
+                if ((static_cast<std::size_t>(fps->count.get()) + 1 == this->size())
+                    && fps->insert_print(pos, page::bpt_key_fingerprints::make_fingerprint(key))) {
+                    return;
+                }
+                rebuild_prints(fps);
+            }
+
+            void prints_erased(page::bpt_key_fingerprints* fps, std::size_t pos) {
+                if (fps == nullptr) {
+                    return;
+                }
+                if ((fps->count.get() == this->size() + 1) && fps->erase_print(pos)) {
+                    return;
+                }
+                rebuild_prints(fps);
+            }
+
+            // Whether `v` is kept out of line: it already is (moved by the tree), it is longer
+            // than the overflow threshold, or it would not fit into a leaf slot. `key_len` is
+            // the number of bytes the slot keeps for the key.
+            bool goes_external(std::size_t key_len, value_in_type v) const {
+                if constexpr (value_overflow) {
+                    if (v.external) {
+                        return true;
+                    }
+                    const auto inline_len = sizeof(page::bpt_leaf_slot) + key_len + v.val.size();
+                    return ((overflow_threshold_ > 0) && (v.val.size() > overflow_threshold_))
+                        || !this->check_length(inline_len);
+                }
+                else {
+                    return false;
+                }
+            }
+
+            std::size_t stored_length(std::size_t key_len, value_in_type v) const {
+                const auto value_len = goes_external(key_len, v) ? sizeof(page::bpt_leaf_external_value) : v.val.size();
+                return sizeof(page::bpt_leaf_slot) + key_len + value_len;
+            }
+
+            // The bytes the slot keeps for `v`. A value going out of line is written to a new
+            // chain here and `record` gets its reference.
+            byte_view store_value(std::size_t key_len, value_in_type v, page::bpt_leaf_external_value& record) {
+                if constexpr (value_overflow) {
+                    if (!v.external && goes_external(key_len, v)) {
+                        long_store_type chain(*overflow_mgr_, long_store_type::invalid_pid);
+                        record.header = chain.create();
+                        record.size = v.val.size();
+                        [[maybe_unused]] const auto written = chain.write(v.val.data(), v.val.size());
+                        DB_ASSERT(written == v.val.size(), "long_store write failed");
+                        return { reinterpret_cast<const core::byte*>(&record), sizeof(record) };
+                    }
+                }
+                return v.val;
+            }
+
+            // The chain header of an out-of-line slot value, or invalid_pid.
+            static pid_type external_chain(byte_view slot) {
+                const auto* hdr = reinterpret_cast<const page::bpt_leaf_slot*>(slot.data());
+                if (hdr->is_external()) {
+                    const auto value = leaf_value_extractor{}(slot);
+                    return reinterpret_cast<const page::bpt_leaf_external_value*>(value.data())->header.get();
+                }
+                return long_store_type::invalid_pid;
+            }
+
+            void drop_chain(pid_type header) {
+                if constexpr (value_overflow) {
+                    if (header != long_store_type::invalid_pid) {
+                        long_store_type chain(*overflow_mgr_, header);
+                        chain.resize(0);
+                        overflow_mgr_->destroy(header);
+                    }
+                }
+            }
+
+            // set by the accessor for value_overflow models
+            buffer_manager_type* overflow_mgr_ = nullptr;
+            std::size_t overflow_threshold_ = 0;
         };
 
         struct inode_type: public node_base {
@@ -500,6 +1161,15 @@ namespace fulla::bpt::paged {
             }
 
             std::size_t key_position(key_like_type k) const {
+                if constexpr (prefix_keys) {
+                    return this->template stored_search<true>(k.key);
+                }
+                else if constexpr (page::BytewiseKeyLess<less_type>) {
+                    if (const auto* idx = heads_index(); idx && idx->count.get() == this->size()) {
+                        return this->template heads_search<true>(*idx, k.key);
+                    }
+                    return this->template prefix_search<true>(k.key);
+                }
                 auto pv = this->get_page();
                 auto slots = pv.get_slots_dir();
                 auto slots_view = slots.view();
@@ -514,37 +1184,58 @@ namespace fulla::bpt::paged {
             bool update_key(std::size_t pos, key_like_type k) {
                 auto slots = this->get_slots();
                 const auto old_data = slots.get_slot(pos);
-                const auto* old_slot_hdr = reinterpret_cast<const page::bpt_inode_slot*>(old_data.data());
-                const auto old_child_value = old_slot_hdr->child;
-                const auto new_len = sizeof(page::bpt_inode_slot) + k.key.size();
+                const auto old_slot = *reinterpret_cast<const inode_slot_type*>(old_data.data());
+                const auto new_len = sizeof(inode_slot_type) + this->stored_key_size(k.key);
                 if (new_len > maximum_inode_slot_size) {
                     DB_ASSERT(false, "something went wrong");
                     return false;
                 }
                 if (slots.update_reserve(pos, new_len)) {
                     auto new_value = slots.get_slot(pos);
-                    auto* slot_hdr = reinterpret_cast<page::bpt_inode_slot*>(new_value.data());
-                    slot_hdr->child = old_child_value;
-                    std::memcpy(new_value.data() + slot_hdr->key_offset(), k.key.data(), k.key.size());
+                    auto* slot_hdr = reinterpret_cast<inode_slot_type*>(new_value.data());
+                    *slot_hdr = old_slot;
+                    this->store_key(k.key, new_value.data() + slot_hdr->key_offset());
+                    this->rebuild_heads(heads_index());
                     return this->check_mark_dirty(true);
                 }
                 DB_ASSERT(false, "something went wrong");
                 return false; // ?
             }
 
-            void set_parent(node_id_type new_value) {
+            bool erase(std::size_t pos) {
+                if (node_base::erase(pos)) {
+                    this->heads_erased(heads_index(), pos);
+                    return true;
+                }
+                return false;
+            }
+
+            void set_parent(node_id_type new_value) requires parent_links {
                 page_view_type pv = this->get_page();
-                auto* inode_hdr = pv.subheader<page::bpt_inode_header>();
+                auto* inode_hdr = pv.subheader<inode_header_type>();
                 inode_hdr->parent = new_value;
                 this->check_mark_dirty(true);
             }
 
-            node_id_type get_parent() {
+            node_id_type get_parent() requires parent_links {
                 page_view_type pv = this->get_page();
-                auto* inode_hdr = pv.subheader<page::bpt_inode_header>();
+                auto* inode_hdr = pv.subheader<inode_header_type>();
                 return inode_hdr->parent;
             }
 
+            void set_next(node_id_type nv) requires inode_links {
+                auto pv = this->get_page();
+                auto hdr = pv.subheader<inode_header_type>();
+                hdr->next = nv;
+                this->check_mark_dirty(true);
+            }
+
+            node_id_type get_next() const requires inode_links {
+                auto pv = this->get_page();
+                auto hdr = pv.subheader<const inode_header_type>();
+                return hdr->next;
+            }
+
             node_id_type get_child(std::size_t pos) const {
                 if (auto c_ptr = get_child_ptr(pos)) {
                     return static_cast<node_id_type>(*c_ptr);
@@ -554,7 +1245,7 @@ namespace fulla::bpt::paged {
 
             bool can_insert_child(std::size_t, key_like_type k, node_id_type) const {
                 const auto slots = this->get_slots();
-                const auto full_slot_size = (k.key.size() + sizeof(page::bpt_inode_slot));
+                const auto full_slot_size = (this->stored_key_size(k.key) + sizeof(inode_slot_type));
 
                 return (full_slot_size >= this->minimum_len) 
                     && (full_slot_size <= this->maximum_len)
@@ -567,15 +1258,18 @@ namespace fulla::bpt::paged {
 
             bool insert_child(std::size_t pos, key_like_type k, node_id_type c) {
                 auto slots = this->get_slots();
-                const auto full_len = k.key.size() + sizeof(page::bpt_inode_slot);
+                this->reset_prefix(k.key);
+                const auto full_len = this->stored_key_size(k.key) + sizeof(inode_slot_type);
                 if (full_len > maximum_inode_slot_size) {
                     return false;
                 }
                 if (slots.reserve(pos, full_len)) {
                     auto new_slot = slots.get_slot(pos);
-                    auto slot_hdr = reinterpret_cast<page::bpt_inode_slot*>(new_slot.data());
+                    auto slot_hdr = reinterpret_cast<inode_slot_type*>(new_slot.data());
+                    *slot_hdr = inode_slot_type{};
                     slot_hdr->child = c;
-                    std::memcpy(new_slot.data() + slot_hdr->key_offset(), k.key.data(), k.key.size());
+                    this->store_key(k.key, new_slot.data() + slot_hdr->key_offset());
+                    this->heads_inserted(heads_index(), pos, k.key);
                     return this->check_mark_dirty(true);
                 }
                 return false;
@@ -589,18 +1283,59 @@ namespace fulla::bpt::paged {
                 return false;
             }
 
+            page::bpt_key_heads* heads_index() const {
+                return this->template subheader_block<inode_header_type, page::bpt_key_heads>();
+            }
+
+            virtual page::bpt_key_prefix* key_prefix() const {
+                if constexpr (prefix_keys) {
+                    return this->template subheader_block<inode_header_type, page::bpt_key_prefix>();
+                }
+                else {
+                    return nullptr;
+                }
+            }
+
+            std::size_t get_count(std::size_t pos) const requires child_counts {
+                if (auto c_ptr = get_count_ptr(pos)) {
+                    return c_ptr->get();
+                }
+                return 0;
+            }
+
+            void set_count(std::size_t pos, std::size_t value) requires child_counts {
+                if (auto c_ptr = get_count_ptr(pos)) {
+                    *c_ptr = static_cast<core::word_u32::word_type>(value);
+                    this->check_mark_dirty(true);
+                }
+            }
+
         private:
+            core::word_u32* get_count_ptr(std::size_t pos) const requires child_counts {
+                auto slots = this->get_slots();
+                const auto slot_size = slots.size();
+                if (pos < slot_size) {
+                    auto value = slots.get_slot(pos);
+                    return &reinterpret_cast<inode_slot_type*>(value.data())->count;
+                }
+                else if (pos == slot_size) {
+                    auto pv = this->get_page();
+                    return &pv.subheader<inode_header_type>()->rightmost_count;
+                }
+                return nullptr;
+            }
+
             auto get_child_ptr(std::size_t pos) const -> decltype(page::bpt_inode_slot::child) * {
                 auto slots = this->get_slots();
                 const auto slot_size = slots.size();
                 if (pos < slot_size) {
                     auto value = slots.get_slot(pos);
-                    auto slot_hdr = reinterpret_cast<page::bpt_inode_slot*>(value.data());
+                    auto slot_hdr = reinterpret_cast<inode_slot_type*>(value.data());
                     return &slot_hdr->child;
                 }
                 else if(pos == slot_size) {
                     auto pv = this->get_page();
-                    auto sub_hdr = pv.subheader<page::bpt_inode_header>();
+                    auto sub_hdr = pv.subheader<inode_header_type>();
                     return &sub_hdr->rightmost_child;
                 }
                 return nullptr;
@@ -666,11 +1401,18 @@ namespace fulla::bpt::paged {
                 if (new_page.is_valid()) {
                     auto pv = page_view_type{ new_page.rw_span() };
                     const auto page_id = new_page.pid();
+                    const auto heads = prefix_keys ? 0
+                        : sett_.leaf_search_heads - sett_.leaf_search_heads % page::bpt_key_heads::block_len;
+                    const auto heads_size = (heads > 0) ? page::bpt_key_heads::bytes_for(heads) : 0;
+                    const auto prints = prefix_keys ? 0
+                        : sett_.leaf_fingerprints - sett_.leaf_fingerprints % page::bpt_key_fingerprints::block_len;
+                    const auto prints_size = (prints > 0) ? page::bpt_key_fingerprints::bytes_for(prints) : 0;
+                    const auto prefix_size = prefix_keys ? page::bpt_key_prefix::bytes_for(sett_.key_prefix_size) : 0;
                     pv.header().init(
                         leaf_kind_value,
                         mgr_->page_size(), 
                         page_id,
-                        sizeof(page::bpt_leaf_header),
+                        sizeof(page::bpt_leaf_header) + heads_size + prints_size + prefix_size,
                         page::metadata_size<leaf_metadata_type>());
                     pv.get_slots_dir().init();
                     auto subhdr = pv.subheader<page::bpt_leaf_header>();
@@ -678,17 +1420,23 @@ namespace fulla::bpt::paged {
                     subhdr->parent = invalid_node_value;
                     subhdr->next = invalid_node_value;
                     subhdr->prev = invalid_node_value;
+                    if (heads > 0) {
+                        reinterpret_cast<page::bpt_key_heads*>(subhdr + 1)->init(heads);
+                    }
+                    if (prints > 0) {
+                        auto* at = reinterpret_cast<core::byte*>(subhdr + 1) + heads_size;
+                        reinterpret_cast<page::bpt_key_fingerprints*>(at)->init(prints);
+                    }
+                    if constexpr (prefix_keys) {
+                        reinterpret_cast<page::bpt_key_prefix*>(subhdr + 1)->init(sett_.key_prefix_size);
+                    }
 
                     if constexpr (core::concepts::HasInit<leaf_metadata_type>) {
                         pv.metadata_as<leaf_metadata_type>()->init();
                     }
 
                     new_page.mark_dirty();
-                    return { 
-                        pv, page_id, std::move(new_page), 
-                        sett_.leaf_minimum_slot_size, 
-                        sett_.leaf_maximum_slot_size 
-                    };
+                    return make_leaf(pv, page_id, std::move(new_page));
                 }
                 return {};
             }
@@ -698,15 +1446,28 @@ namespace fulla::bpt::paged {
                 if (new_page.is_valid()) {
                     auto pv = page_view_type{ new_page.rw_span() };
                     const auto page_id = new_page.pid();
+                    const auto heads = prefix_keys ? 0
+                        : sett_.inode_search_heads - sett_.inode_search_heads % page::bpt_key_heads::block_len;
+                    const auto heads_size = (heads > 0) ? page::bpt_key_heads::bytes_for(heads) : 0;
+                    const auto prefix_size = prefix_keys ? page::bpt_key_prefix::bytes_for(sett_.key_prefix_size) : 0;
                     pv.header().init(inode_kind_value, 
                         mgr_->page_size(), 
                         page_id, 
-                        sizeof(page::bpt_inode_header),
+                        sizeof(inode_header_type) + heads_size + prefix_size,
                         page::metadata_size<inode_metadata_type>());
                     pv.get_slots_dir().init();
-                    auto subhdr = pv.subheader<page::bpt_inode_header>();
+                    auto subhdr = pv.subheader<inode_header_type>();
                     subhdr->init();
                     subhdr->parent = invalid_node_value;
+                    if constexpr (inode_links) {
+                        subhdr->next = invalid_node_value;
+                    }
+                    if (heads > 0) {
+                        reinterpret_cast<page::bpt_key_heads*>(subhdr + 1)->init(heads);
+                    }
+                    if constexpr (prefix_keys) {
+                        reinterpret_cast<page::bpt_key_prefix*>(subhdr + 1)->init(sett_.key_prefix_size);
+                    }
 
                     if constexpr (core::concepts::HasInit<inode_metadata_type>) {
                         pv.metadata_as<inode_metadata_type>()->init();
@@ -734,11 +1495,7 @@ namespace fulla::bpt::paged {
                     auto pv = page_view_type{ data };
                     const auto kind = pv.header().kind.get();
                     if (kind == static_cast<std::uint16_t>(leaf_kind_value)) {
-                        return leaf_type{ pv, page_id, 
-                            std::move(new_page),
-                            sett_.leaf_minimum_slot_size,
-                            sett_.leaf_maximum_slot_size,
-                        };
+                        return make_leaf(pv, page_id, std::move(new_page));
                     }
                 }
                 return {};
@@ -762,7 +1519,22 @@ namespace fulla::bpt::paged {
                 return {};
             }
 
+            leaf_type make_leaf(page_view_type pv, node_id_type page_id, page_handle ph) {
+                leaf_type leaf{ pv, page_id, std::move(ph),
+                    sett_.leaf_minimum_slot_size,
+                    sett_.leaf_maximum_slot_size
+                };
+                if constexpr (value_overflow) {
+                    leaf.overflow_mgr_ = mgr_;
+                    leaf.overflow_threshold_ = sett_.leaf_value_overflow;
+                }
+                return leaf;
+            }
+
             bool can_merge_leafs(const leaf_type& dst, const leaf_type& src) const {
+                if constexpr (prefix_keys) {
+                    return dst.get_slots().available_after_compact() >= merge_need_bytes(dst, src);
+                }
                 return slots::can_merge(dst.get_page().get_slots_dir(), src.get_page().get_slots_dir());
             }
             
@@ -771,6 +1543,9 @@ namespace fulla::bpt::paged {
                 const auto src_slots = src.get_page().get_slots_dir();
                 const auto dst_available = dst_slots.available_after_compact();
  
+                if constexpr (prefix_keys) {
+                    return dst_available >= merge_need_bytes(dst, src) + maximum_inode_slot_size;
+                }
                 const auto need_size = slots::merge_need_bytes(dst_slots, src_slots) + maximum_inode_slot_size;
 
                 if (dst_available < need_size) {
@@ -779,6 +1554,25 @@ namespace fulla::bpt::paged {
                 return slots::can_merge(dst.get_page().get_slots_dir(), src.get_page().get_slots_dir());
             }
 
+            // prefix_keys models: the bytes the slots of `src` take once their keys are stored
+            // against the prefix of `dst`. An empty `dst` is counted without a prefix, which
+            // is the most the keys can take there.
+            static std::size_t merge_need_bytes(const node_base& dst, const node_base& src) {
+                const auto dst_slots = dst.get_slots();
+                const auto src_slots = src.get_slots();
+                const auto prefix = (dst.size() > 0) ? dst.key_prefix()->view() : byte_view{};
+                std::size_t need = 0;
+                for (std::size_t i = 0; i < src_slots.size(); ++i) {
+                    const auto slot = src_slots.get_slot(i);
+                    const auto stored = src.extract_key(slot);
+                    const auto key = src.load_key(stored);
+                    const auto key_len = 1 + key.size() - page::bpt_key_prefix::shared(prefix, key);
+                    need += dst_slots.fixed_len(slot.size() - stored.size() + key_len)
+                        + sizeof(typename slot_directory_type::slot_type);
+                }
+                return need;
+            }
+
             std::tuple<node_id_type, bool> load_root() {
                 const auto value = root_.get_root();
                 const bool exists = root_.has_root() && (value != invalid_node_value);
@@ -797,7 +1591,8 @@ namespace fulla::bpt::paged {
 
         static_assert(concepts::NodeAccessor<accessor_type, node_id_type, inode_type, leaf_type>);
 
-        static key_like_type key_out_as_like(key_out_type kout) {
+        // The result views `kout`, which has to outlive it.
+        static key_like_type key_out_as_like(const key_out_type& kout) {
             const key_like_type res = { kout.key };
             return res;
         }
@@ -806,18 +1601,48 @@ namespace fulla::bpt::paged {
             return { kbor.key };
         }
 
+        // For overflow models the result still refers to the stored chain, so it is meant for
+        // moving elements inside the tree; copy a value elsewhere through load().
         static value_in_type value_out_as_in(value_out_type vout) {
-            return { vout.val };
+            if constexpr (value_overflow) {
+                return vout.is_external() ? value_in_type{ vout.ref, true } : value_in_type{ vout.val, false };
+            }
+            else {
+                return { vout.val };
+            }
         }
 
         static value_in_type value_borrow_as_in(const value_borrow_type &vbor) {
-            return { vbor.val };
+            if constexpr (value_overflow) {
+                return { vbor.val, vbor.external };
+            }
+            else {
+                return { vbor.val };
+            }
+        }
+
+        static bool key_less(key_like_type a, key_like_type b) {
+            return make_key_less()(a.key, b.key);
+        }
+
+        // The shortest prefix of `right` that is still greater than `left`.
+        static key_borrow_type make_separator(key_like_type left, key_like_type right)
+            requires page::BytewiseKeyLess<less_type> 
+        {
+            const auto diff = std::ranges::mismatch(left.key, right.key).in2;
+            const auto len = std::min<std::size_t>(std::distance(right.key.begin(), diff) + 1, right.key.size());
+            return { .key = byte_buffer(right.key.begin(), right.key.begin() + len) };
         }
 
         bool is_valid_id(node_id_type id) {
             return (id != invalid_node_value) && (accessor_.mgr_->valid_id(id));
         }
 
+        // see concepts::ModelSharedNodes
+        bool shares_nodes_with(const model& other) const noexcept {
+            return accessor_.mgr_ == other.accessor_.mgr_;
+        }
+
         bool is_leaf_id(node_id_type id) {
             auto p = accessor_.mgr_->fetch(id);
             if (p.is_valid()) {
@@ -17,5 +17,17 @@ namespace fulla::bpt::paged {
         std::size_t inode_maximum_slot_size = 200; 
         std::size_t leaf_minimum_slot_size = 4; 
         std::size_t leaf_maximum_slot_size = 200; 
+        // Keys covered by the node search index (page::bpt_key_heads), rounded down to
+        // a multiple of 16; 0 creates nodes without it. Byte-ordered keys only.
+        std::size_t inode_search_heads = 0;
+        std::size_t leaf_search_heads = 0;
+        // Keys covered by the leaf fingerprints (page::bpt_key_fingerprints) used by find().
+        std::size_t leaf_fingerprints = 0;
+        // Models with overflow_bpt_descriptor: values longer than this go to a long_store
+        // chain; 0 moves out only the values that don't fit into a leaf slot.
+        std::size_t leaf_value_overflow = 0;
+        // Models with prefix_bpt_descriptor: bytes of the page prefix (page::bpt_key_prefix)
+        // kept by every node, at most 255. Replaces the heads and fingerprints there.
+        std::size_t key_prefix_size = 32;
     };
 }
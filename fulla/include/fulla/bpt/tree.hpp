@@ -13,6 +13,17 @@
 #include <format>
 #include <sstream>
 #include <cassert>
+#include <vector>
+#include <ranges>
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <unordered_map>
+#include <type_traits>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <exception>
 
 #include "fulla/core/debug.hpp"
 #include "fulla/bpt/concepts.hpp"
@@ -39,6 +50,13 @@ namespace fulla::bpt {
         using node_id_type = typename ModelT::node_id_type;
         using leaf_type = typename ModelT::leaf_type;
         using inode_type = typename ModelT::inode_type;
+        using cursor_type = cursor<ModelT>;
+
+        constexpr static const bool has_parent_links = concepts::NodeParentLink<leaf_type>
+            && concepts::NodeParentLink<inode_type>;
+
+        constexpr static const bool has_inode_links = concepts::InodeRightLink<inode_type>;
+        constexpr static const bool has_child_counts = concepts::InodeChildCounts<inode_type>;
 
         constexpr static const std::size_t npos = std::numeric_limits<std::size_t>::max();
 
@@ -139,7 +157,12 @@ namespace fulla::bpt {
             }
 
             iterator& operator+=(difference_type n) {
-                if (n >= 0) {
+                if constexpr (has_child_counts) {
+                    if (n != 0) {
+                        jump(n);
+                    }
+                }
+                else if (n >= 0) {
                     while (n--) {
                         ++(*this);
                     }
@@ -185,6 +208,29 @@ namespace fulla::bpt {
                 return *cache_;
             }
 
+            // Moves within the leaf when it can; otherwise rank() + nth(), two descents
+            // instead of a walk over every element in between.
+            void jump(difference_type n) {
+                invalidate_cache();
+                std::size_t from = 0;
+                if (is_end()) {
+                    from = tree_->total_count_();
+                }
+                else {
+                    auto leaf = tree_->model_.get_accessor().load_leaf(leaf_id_);
+                    const auto target = static_cast<difference_type>(idx_) + n;
+                    if ((target >= 0) && (target < static_cast<difference_type>(leaf.size()))) {
+                        idx_ = static_cast<std::size_t>(target);
+                        return;
+                    }
+                    from = tree_->rank(tree_->model_.key_out_as_like(leaf.get_key(idx_)));
+                }
+                DB_ASSERT((n > 0) || (static_cast<std::size_t>(-n) <= from), "iterator moved before begin()");
+                const auto it = tree_->nth(static_cast<std::size_t>(static_cast<difference_type>(from) + n));
+                leaf_id_ = it.leaf_id_;
+                idx_ = it.idx_;
+            }
+
             void invalidate_cache() {
                 cache_.reset();
             }
@@ -209,6 +255,28 @@ namespace fulla::bpt {
             bool found = false;
         };
 
+        struct path_step {
+            node_id_type node = {};
+            std::size_t pos = 0;
+        };
+
+        /// Shape of the leaf level, see layout() and compact().
+        struct layout_stats {
+            std::size_t leaves = 0;
+            std::size_t inodes = 0;
+            std::size_t elements = 0;
+            /// Average leaf fill, 0..1.
+            double fill = 0.0;
+            /// Share of next links that lead back to a lower node id, 0..1; a scan seeks
+            /// backwards on each of them. Models with unordered ids report 0.
+            double fragmentation = 0.0;
+        };
+
+        struct compact_report {
+            layout_stats before;
+            layout_stats after;
+        };
+
         iterator begin() {
             auto [root, exists] = get_accessor().load_root();
             if (exists) {
@@ -224,10 +292,50 @@ namespace fulla::bpt {
             return iterator(this, get_invalid_id(), 0);
         }
 
+        /// Cursor at the first element. See cursor.hpp.
+        cursor_type make_cursor() {
+            auto [root, exists] = get_accessor().load_root();
+            if (exists) {
+                return cursor_type(model_, get_accessor().load_leaf(get_leftmost_leaf(root)), 0);
+            }
+            return {};
+        }
+
+        /// Cursor at the first element whose key is not less than `key`.
+        cursor_type make_cursor(const key_like_type& key) {
+            auto [nodeid, pos, found] = find_node_with<false, true>(key);
+            if (model_.is_valid_id(nodeid)) {
+                return cursor_type(model_, get_accessor().load_leaf(nodeid), pos);
+            }
+            return {};
+        }
+
+        /// Cursor at the last element; walk it with prev().
+        cursor_type make_cursor_last() {
+            auto [root, exists] = get_accessor().load_root();
+            if (exists) {
+                auto leaf = get_accessor().load_leaf(get_rightmost_leaf(root));
+                const auto size = leaf.size();
+                if (size > 0) {
+                    return cursor_type(model_, std::move(leaf), size - 1);
+                }
+            }
+            return {};
+        }
+
         void set_rebalance_policy(policies::rebalance rp) {
             rp_ = rp;
         }
 
+        /// For keys that mostly arrive in ascending order (logs, time series). A key above
+        /// the current maximum goes straight to the remembered rightmost leaf without a
+        /// descent, and when that leaf is full the key opens a new leaf instead of splitting
+        /// it in halves, so the leaves left behind stay full. Other keys take the usual path.
+        void set_append_mode(bool on) {
+            append_mode_ = on;
+            append_leaf_ = get_invalid_id();
+        }
+
         bool insert(const key_like_type& key, value_in_type value, 
             policies::insert ip = policies::insert::insert) {
             auto& accessor = get_accessor();
@@ -239,10 +347,19 @@ namespace fulla::bpt {
                 return true;
             }
             else {
+                if (append_mode_) {
+                    start_operation_();
+                    if (auto leaf = load_append_leaf(key); leaf.is_valid()) {
+                        return append_value(leaf, key, std::move(value));
+                    }
+                }
                 auto [node_id, pos, found] = find_node_with_(key, root);
                 auto leaf = accessor.load_leaf(node_id);
                 if (!found) {
-                    if (!leaf.can_insert_value(pos, key, value)) {
+                    if (append_mode_ && (pos == leaf.size()) && !model_.is_valid_id(leaf.get_next())) {
+                        return append_value(leaf, key, std::move(value));
+                    }
+                    else if (!leaf.can_insert_value(pos, key, value)) {
                         if (rp_ == policies::rebalance::force_split) {
                             handle_leaf_overflow_default(leaf, key, std::move(value), pos, rp_);
                         }
@@ -251,9 +368,11 @@ namespace fulla::bpt {
                                 handle_leaf_overflow_default(leaf, key, std::move(value), pos, rp_);
                             }
                         }
+                        settle_counts_();
                     }
                     else {
                         leaf.insert_value(pos, key, std::move(value));
+                        adjust_counts_(leaf, 1);
                     }
                     return true;
                 }
@@ -265,6 +384,460 @@ namespace fulla::bpt {
             return false;
         }
 
+        /// Builds the tree bottom-up from key-sorted input. The tree must be empty.
+        /// Elements are (key_like_type, value_in_type) pairs with strictly increasing keys.
+        /// Leaves are filled left to right up to `fill_factor` and linked with next/prev,
+        /// inode levels are built on the fly from the first key of every new node.
+        template <std::ranges::input_range RangeT>
+        bool bulk_load(RangeT&& input, double fill_factor = 1.0) {
+            DB_ASSERT((fill_factor > 0.0) && (fill_factor <= 1.0), "fill_factor must be in (0, 1]");
+            auto& accessor = get_accessor();
+            if (auto [root, exists] = accessor.load_root(); exists) {
+                return false;
+            }
+
+            std::vector<inode_type> open_inodes;
+            std::vector<node_id_type> created;
+            leaf_type leaf;
+            for (auto&& element : input) {
+                auto&& [key_in, value_in] = element;
+                if (!bulk_append_value(open_inodes, leaf, created, key_in, value_in, fill_factor)) {
+                    bulk_abort(open_inodes, leaf, created);
+                    return false;
+                }
+            }
+            if (leaf.is_valid()) {
+                bulk_finish(open_inodes, leaf);
+            }
+            return true;
+        }
+
+        /// Walks the leaf level and reports its fill and how often the leaf chain
+        /// runs against node id order.
+        layout_stats layout() {
+            auto& accessor = get_accessor();
+            layout_stats result;
+            auto [root, exists] = accessor.load_root();
+            if (!exists) {
+                return result;
+            }
+            std::vector<node_id_type> level{ root };
+            while (!model_.is_leaf_id(level.front())) {
+                std::vector<node_id_type> below;
+                for (auto id : level) {
+                    auto inode = accessor.load_inode(id);
+                    for (std::size_t i = 0; i <= inode.size(); ++i) {
+                        below.push_back(inode.get_child(i));
+                    }
+                }
+                result.inodes += level.size();
+                level = std::move(below);
+            }
+
+            double fill = 0.0;
+            std::size_t jumps = 0;
+            for (auto id = level.front(); model_.is_valid_id(id);) {
+                auto leaf = accessor.load_leaf(id);
+                ++result.leaves;
+                result.elements += leaf.size();
+                fill += leaf_fill(leaf);
+                const auto next = leaf.get_next();
+                if (model_.is_valid_id(next) && !ahead_in_storage(id, next)) {
+                    ++jumps;
+                }
+                id = next;
+            }
+            result.fill = fill / static_cast<double>(result.leaves);
+            if (result.leaves > 1) {
+                result.fragmentation = static_cast<double>(jumps) / static_cast<double>(result.leaves - 1);
+            }
+            return result;
+        }
+
+        /// Rewrites the tree into freshly allocated nodes: the leaf chain is streamed
+        /// left to right into leaves filled up to `fill_factor`, so sparse leaves left by
+        /// removes are merged and the new leaves get ascending page ids; the inode levels
+        /// are rebuilt on top as in bulk_load(). The old nodes are destroyed only when the
+        /// new tree is complete; if allocation fails, the tree is left as it was and the
+        /// result is empty. Iterators and cursors are invalidated.
+        std::optional<compact_report> compact(double fill_factor = 1.0) {
+            DB_ASSERT((fill_factor > 0.0) && (fill_factor <= 1.0), "fill_factor must be in (0, 1]");
+            auto& accessor = get_accessor();
+            compact_report report;
+            report.before = layout();
+            auto [root, exists] = accessor.load_root();
+            if (!exists) {
+                return report;
+            }
+
+            std::vector<node_id_type> old_nodes;
+            std::vector<node_id_type> level{ root };
+            while (!model_.is_leaf_id(level.front())) {
+                std::vector<node_id_type> below;
+                for (auto id : level) {
+                    auto inode = accessor.load_inode(id);
+                    for (std::size_t i = 0; i <= inode.size(); ++i) {
+                        below.push_back(inode.get_child(i));
+                    }
+                }
+                old_nodes.insert(old_nodes.end(), level.begin(), level.end());
+                level = std::move(below);
+            }
+            old_nodes.insert(old_nodes.end(), level.begin(), level.end());
+
+            std::vector<inode_type> open_inodes;
+            std::vector<node_id_type> created;
+            leaf_type leaf;
+            for (auto id : level) {
+                auto old_leaf = accessor.load_leaf(id);
+                for (std::size_t i = 0; i < old_leaf.size(); ++i) {
+                    if (!bulk_append_value(open_inodes, leaf, created, model_.key_out_as_like(old_leaf.get_key(i)),
+                        model_.value_out_as_in(old_leaf.get_value(i)), fill_factor)) {
+                        bulk_abort(open_inodes, leaf, created);
+                        return std::nullopt;
+                    }
+                }
+            }
+
+            descent_path_.clear();
+            counts_dirty_.clear();
+            if (leaf.is_valid()) {
+                bulk_finish(open_inodes, leaf);
+            }
+            else {
+                accessor.set_root(get_invalid_id());
+            }
+            open_inodes.clear();
+            leaf = {};
+            for (auto id : old_nodes) {
+                drop_node(id);
+            }
+            report.after = layout();
+            return report;
+        }
+
+        /// Moves the elements with keys at `key` and above into `right`, an empty tree over
+        /// the same storage (concepts::ModelSharedNodes). The nodes change hands as they
+        /// are: only the leaf and the inodes on the path to `key` are cut in two, and the
+        /// two new edges are rebalanced as after a remove. With parent links the children
+        /// of a cut inode that go right are relinked as well. Returns false, with both trees
+        /// as they were, if a node can't be allocated. Iterators and cursors of both trees
+        /// are invalidated.
+        bool split_at(key_like_type key, tree& right) requires concepts::ModelSharedNodes<model_type> {
+            auto& accessor = get_accessor();
+            auto& right_accessor = right.get_accessor();
+            DB_ASSERT(model_.shares_nodes_with(right.model_), "split_at needs a tree over the same storage");
+            DB_ASSERT(!std::get<1>(right_accessor.load_root()), "split_at needs an empty right tree");
+
+            const auto first = lower_bound(key);
+            if (first == end()) {
+                return true;
+            }
+            forget_hints_();
+            right.forget_hints_();
+            if (first == begin()) {
+                auto [root, _] = accessor.load_root();
+                right_accessor.set_root(root);
+                accessor.set_root(get_invalid_id());
+                return true;
+            }
+
+            std::vector<path_step> path;
+            auto leaf = accessor.load_leaf(descend_steps_(key, path));
+            const auto pos = leaf.key_position(key);
+
+            // which nodes on the path keep elements on both sides of `key` and are cut in
+            // two; all of them are allocated up front
+            std::vector<bool> cut(path.size());
+            bool left_part = (pos > 0);
+            bool right_part = (pos < leaf.size());
+            const bool cut_leaf = left_part && right_part;
+            std::size_t inodes_needed = 0;
+            for (auto d = path.size(); d-- > 0;) {
+                auto node = accessor.load_inode(path[d].node);
+                left_part = left_part || (path[d].pos > 0);
+                right_part = right_part || (path[d].pos < node.size());
+                cut[d] = left_part && right_part;
+                inodes_needed += cut[d] ? 1 : 0;
+            }
+            leaf_type right_leaf;
+            std::vector<inode_type> fresh;
+            bool allocated = true;
+            if (cut_leaf) {
+                right_leaf = accessor.create_leaf();
+                allocated = right_leaf.is_valid();
+            }
+            while (allocated && (fresh.size() < inodes_needed)) {
+                fresh.push_back(accessor.create_inode());
+                allocated = fresh.back().is_valid();
+            }
+            if (!allocated) {
+                if (right_leaf.is_valid()) {
+                    drop_node(right_leaf.self());
+                }
+                for (auto& node : fresh) {
+                    if (node.is_valid()) {
+                        drop_node(node.self());
+                    }
+                }
+                return false;
+            }
+
+            // the left and the right part of the child cut at the level below
+            auto left_child = (pos > 0) ? leaf.self() : get_invalid_id();
+            auto right_child = (pos < leaf.size()) ? leaf.self() : get_invalid_id();
+            if (cut_leaf) {
+                for (auto i = pos; i < leaf.size(); ++i) {
+                    auto borrowed_key = leaf.borrow_key(i);
+                    auto borrowed_val = leaf.borrow_value(i);
+                    right_leaf.insert_value(right_leaf.size(), model_.key_borrow_as_like(borrowed_key),
+                        model_.value_borrow_as_in(borrowed_val));
+                }
+                while (leaf.size() > pos) {
+                    leaf.erase(leaf.size() - 1);
+                }
+                right_leaf.set_next(leaf.get_next());
+                if (auto next = accessor.load_leaf(leaf.get_next()); next.is_valid()) {
+                    next.set_prev(right_leaf.self());
+                }
+                right_child = right_leaf.self();
+            }
+
+            for (auto d = path.size(); d-- > 0;) {
+                auto node = accessor.load_inode(path[d].node);
+                const auto at = path[d].pos;
+                if (!cut[d]) {
+                    // nothing was cut below, the node goes to one side as it is
+                    const bool goes_left = model_.is_valid_id(left_child);
+                    left_child = goes_left ? node.self() : get_invalid_id();
+                    right_child = goes_left ? get_invalid_id() : node.self();
+                    continue;
+                }
+                auto right_node = std::move(fresh.back());
+                fresh.pop_back();
+                const bool has_left = model_.is_valid_id(left_child);
+                const bool has_right = model_.is_valid_id(right_child);
+
+                // right_node: the right part of the cut child, then the entries after it
+                auto pending = has_right ? right_child : node.get_child(at + 1);
+                for (auto i = has_right ? at : at + 1; i < node.size(); ++i) {
+                    auto borrowed_key = node.borrow_key(i);
+                    right_node.insert_child(right_node.size(), model_.key_borrow_as_like(borrowed_key), pending);
+                    right.link_parent_id(pending, right_node.self());
+                    pending = node.get_child(i + 1);
+                }
+                right_node.update_child(right_node.size(), pending);
+                right.link_parent_id(pending, right_node.self());
+                if constexpr (has_inode_links) {
+                    right_node.set_next(node.get_next());
+                }
+
+                // node: the entries before the cut child, then its left part
+                const auto keep = has_left ? at : at - 1;
+                if (node.size() > keep) {
+                    swap_children(node, keep, node.size());
+                    while (node.size() > keep) {
+                        node.erase(keep);
+                    }
+                }
+                counts_touched_(node.self());
+                right.counts_touched_(right_node.self());
+                left_child = node.self();
+                right_child = right_node.self();
+            }
+            accessor.set_root(left_child);
+            right_accessor.set_root(right_child);
+
+            // the edges where the trees were cut lead nowhere now
+            {
+                auto id = left_child;
+                while (!model_.is_leaf_id(id)) {
+                    auto node = accessor.load_inode(id);
+                    if constexpr (has_inode_links) {
+                        node.set_next(get_invalid_id());
+                    }
+                    id = node.get_child(node.size());
+                }
+                auto last_leaf = accessor.load_leaf(id);
+                last_leaf.set_next(get_invalid_id());
+                handle_leaf_underflow(last_leaf, key);
+                settle_path_(key);
+                settle_counts_();
+            }
+            {
+                auto first_leaf = right_accessor.load_leaf(right.get_leftmost_leaf(right_child));
+                first_leaf.set_prev(get_invalid_id());
+                right.handle_leaf_underflow(first_leaf, key);
+                right.settle_path_(key);
+                right.settle_counts_();
+            }
+            return true;
+        }
+
+        /// Appends the elements of `other`, a tree over the same storage whose keys all sort
+        /// after the keys of this one, and leaves `other` empty. The shorter tree is hung
+        /// as a whole under the edge of the taller one (under a new root for equal heights),
+        /// so only the nodes along the two facing edges change. Returns false, with both
+        /// trees as they were, if a new root can't be allocated. Iterators and cursors of
+        /// both trees are invalidated.
+        bool join(tree& other) requires concepts::ModelSharedNodes<model_type> {
+            auto& accessor = get_accessor();
+            auto& other_accessor = other.get_accessor();
+            DB_ASSERT(model_.shares_nodes_with(other.model_), "join needs a tree over the same storage");
+            DB_ASSERT(this != &other, "a tree can't join itself");
+
+            auto [right_root, right_exists] = other_accessor.load_root();
+            if (!right_exists) {
+                return true;
+            }
+            forget_hints_();
+            other.forget_hints_();
+            auto [left_root, left_exists] = accessor.load_root();
+            if (!left_exists) {
+                accessor.set_root(right_root);
+                other_accessor.set_root(get_invalid_id());
+                return true;
+            }
+
+            // the facing edges, root first
+            std::vector<node_id_type> left_edge{ left_root };
+            while (!model_.is_leaf_id(left_edge.back())) {
+                auto node = accessor.load_inode(left_edge.back());
+                left_edge.push_back(node.get_child(node.size()));
+                remember_parent(left_edge.back(), node.self());
+            }
+            std::vector<node_id_type> right_edge{ right_root };
+            while (!model_.is_leaf_id(right_edge.back())) {
+                auto node = accessor.load_inode(right_edge.back());
+                right_edge.push_back(node.get_child(0));
+                remember_parent(right_edge.back(), node.self());
+            }
+            const auto left_height = left_edge.size() - 1;
+            const auto right_height = right_edge.size() - 1;
+
+            auto last_leaf = accessor.load_leaf(left_edge.back());
+            auto first_leaf = accessor.load_leaf(right_edge.back());
+            DB_ASSERT(model_.key_less(model_.key_out_as_like(last_leaf.get_key(last_leaf.size() - 1)),
+                model_.key_out_as_like(first_leaf.get_key(0))), "join needs keys that sort after this tree");
+            const auto separator = first_leaf.borrow_key(0);
+            const auto key = model_.key_borrow_as_like(separator);
+            const auto left_last = last_leaf.borrow_key(last_leaf.size() - 1);
+
+            inode_type new_root;
+            if (left_height == right_height) {
+                new_root = accessor.create_inode();
+                if (!new_root.is_valid()) {
+                    return false;
+                }
+            }
+            other_accessor.set_root(get_invalid_id());
+
+            last_leaf.set_next(first_leaf.self());
+            first_leaf.set_prev(last_leaf.self());
+            if constexpr (has_inode_links) {
+                for (std::size_t up = 1; up <= std::min(left_height, right_height); ++up) {
+                    accessor.load_inode(left_edge[left_height - up]).set_next(right_edge[right_height - up]);
+                }
+            }
+
+            if (left_height == right_height) {
+                new_root.insert_child(0, key, left_root);
+                new_root.update_child(1, right_root);
+                link_parent_id(left_root, new_root.self());
+                link_parent_id(right_root, new_root.self());
+                accessor.set_root(new_root.self());
+                counts_touched_(new_root.self());
+            }
+            else if (left_height > right_height) {
+                attach_beside_(left_edge[left_height - right_height], key, right_root, false);
+            }
+            else {
+                accessor.set_root(right_root);
+                attach_beside_(right_edge[right_height - left_height], key, left_root, true);
+            }
+
+            // the hung root may be short of elements for a node of its level, and so may
+            // the nodes on its edge facing the other tree
+            settle_path_(key);
+            settle_path_(model_.key_borrow_as_like(left_last));
+            settle_counts_();
+            return true;
+        }
+
+        /// Inserts a batch of (key_like_type, value_in_type) pairs. The batch is sorted in place;
+        /// keys that fall into the same leaf are applied after a single descent.
+        /// Keys that need a split go through the regular insert path.
+        /// Returns the number of keys that were inserted (or updated with insert::upsert).
+        template <typename PairT>
+        std::size_t insert_batch(std::span<PairT> batch, policies::insert ip = policies::insert::insert) {
+            std::ranges::stable_sort(batch, [this](const auto& a, const auto& b) {
+                const auto& [ka, va] = a;
+                const auto& [kb, vb] = b;
+                return model_.key_less(ka, kb);
+            });
+
+            auto& accessor = get_accessor();
+            std::size_t done = 0;
+            std::size_t i = 0;
+            while (i < batch.size()) {
+                start_operation_();
+                auto [root, exists] = accessor.load_root();
+                if (!exists) {
+                    auto& [key, value] = batch[i++];
+                    done += insert(key, value, ip) ? 1 : 0;
+                    continue;
+                }
+
+                inode_type fence;
+                std::size_t fence_pos = 0;
+                auto leaf = accessor.load_leaf(find_leaf_with_fence_(std::get<0>(batch[i]), root, fence, fence_pos));
+                // the counts on the path to the leaf change once for the whole run; they have
+                // to be right before a fallback below splits the leaf
+                std::ptrdiff_t added = 0;
+                const auto settle_added = [&]() {
+                    if (added != 0) {
+                        adjust_counts_(leaf, added);
+                        added = 0;
+                    }
+                };
+                for (bool first = true; i < batch.size(); first = false) {
+                    auto& [key, value] = batch[i];
+                    if (!first && fence.is_valid()
+                        && !model_.key_less(key, model_.key_out_as_like(fence.get_key(fence_pos)))) {
+                        break;
+                    }
+                    ++i;
+                    const auto pos = leaf.key_position(key);
+                    const bool found = (pos != leaf.size()) && leaf.keys_eq(model_.key_out_as_like(leaf.get_key(pos)), key);
+                    if (found) {
+                        if (ip == policies::insert::upsert) {
+                            if (leaf.can_update_value(pos, value)) {
+                                done += leaf.update_value(pos, value) ? 1 : 0;
+                            }
+                            else {
+                                settle_added();
+                                done += update(key, value) ? 1 : 0;
+                                break;
+                            }
+                        }
+                    }
+                    else if (leaf.can_insert_value(pos, key, value)) {
+                        leaf.insert_value(pos, key, value);
+                        ++added;
+                        ++done;
+                    }
+                    else {
+                        // the leaf is full; let the regular path split it and descend again
+                        settle_added();
+                        done += insert(key, value, ip) ? 1 : 0;
+                        break;
+                    }
+                }
+                settle_added();
+            }
+            return done;
+        }
+
         bool update(const key_like_type& key, value_in_type value) {
 
             auto& accessor = get_accessor();
@@ -279,6 +852,7 @@ namespace fulla::bpt {
                 if(!leaf.can_update_value(pos, value)) {
                     if (rp_ == policies::rebalance::force_split) {
                         auto right = handle_leaf_overflow_for_update(leaf, rp_);
+                        settle_counts_();
                         if (pos < leaf.size()) {
                             return leaf.update_value(pos, std::move(value));
                         }
@@ -289,6 +863,7 @@ namespace fulla::bpt {
                     else {
                         if (!try_leaf_neighbor_share_for_update(leaf, value, pos, rp_)) {
                             auto right = handle_leaf_overflow_for_update(leaf, rp_);
+                            settle_counts_();
                             if (pos < leaf.size()) {
                                 return leaf.update_value(pos, std::move(value));
                             }
@@ -340,14 +915,159 @@ namespace fulla::bpt {
 #else   // good but not as good as it could be.
         void erase(iterator where) {
             if (where != end()) {
+                start_operation_();
                 auto node = model_.get_accessor().load_leaf(where.leaf_id_);
                 remove_impl(node, where.idx_);
             }
         }
 #endif 
 
+        /// Removes the elements with keys in [lo, hi) and returns how many there were.
+        /// Subtrees and leaves that lie wholly inside the range are cut off their parents
+        /// and destroyed without visiting their elements one by one (the leaves are not
+        /// read at all when the inodes keep child counts and the values need no release).
+        /// Only the two boundary paths, to the last element below `lo` and to the first
+        /// one at `hi` or above, are trimmed, relinked and rebalanced afterwards.
+        std::size_t erase_range(key_like_type lo, key_like_type hi) {
+            auto& accessor = get_accessor();
+            if (!model_.key_less(lo, hi)) {
+                return 0;
+            }
+            const auto first = lower_bound(lo);
+            const auto last = lower_bound(hi);
+            if (first == last) {
+                return 0;
+            }
+            start_operation_();
+
+            // the elements that stay on both sides of the range
+            std::optional<key_borrow_type> lo_key;
+            std::optional<key_borrow_type> hi_key;
+            {
+                auto leaf = accessor.load_leaf(first.leaf_id_);
+                if (first.idx_ > 0) {
+                    lo_key.emplace(leaf.borrow_key(first.idx_ - 1));
+                }
+                else if (auto prev = accessor.load_leaf(leaf.get_prev()); prev.is_valid()) {
+                    lo_key.emplace(prev.borrow_key(prev.size() - 1));
+                }
+            }
+            if (last != end()) {
+                hi_key.emplace(accessor.load_leaf(last.leaf_id_).borrow_key(last.idx_));
+            }
+
+            std::size_t erased = 0;
+            if (!lo_key && !hi_key) {
+                auto [root, _] = accessor.load_root();
+                erased = drop_subtree_(root);
+                accessor.set_root(get_invalid_id());
+                descent_path_.clear();
+                counts_dirty_.clear();
+                return erased;
+            }
+
+            std::vector<path_step> lo_path;
+            std::vector<path_step> hi_path;
+            leaf_type lo_leaf;
+            leaf_type hi_leaf;
+            if (lo_key) {
+                lo_leaf = accessor.load_leaf(descend_steps_(model_.key_borrow_as_like(*lo_key), lo_path));
+            }
+            if (hi_key) {
+                hi_leaf = accessor.load_leaf(descend_steps_(model_.key_borrow_as_like(*hi_key), hi_path));
+            }
+            const auto depth = lo_key ? lo_path.size() : hi_path.size();
+            const bool both = lo_key && hi_key;
+
+            // the paths share the inodes above `split`; in the inode at `split` the
+            // children between the two paths go whole
+            std::size_t split = 0;
+            if (both) {
+                while ((split < depth) && (lo_path[split].pos == hi_path[split].pos)) {
+                    ++split;
+                }
+            }
+            for (std::size_t d = split; d < depth; ++d) {
+                if (both && (d == split)) {
+                    auto node = accessor.load_inode(lo_path[d].node);
+                    for (auto pos = hi_path[d].pos - 1; pos > lo_path[d].pos; --pos) {
+                        erased += drop_entry_(node, pos);
+                        node.erase(pos);
+                    }
+                    continue;
+                }
+                if (lo_key) {
+                    auto node = accessor.load_inode(lo_path[d].node);
+                    for (auto pos = lo_path[d].pos + 1; pos <= node.size(); ++pos) {
+                        erased += drop_entry_(node, pos);
+                    }
+                    // the rightmost child has no key of its own: the path child takes its place
+                    if (node.size() > lo_path[d].pos) {
+                        swap_children(node, lo_path[d].pos, node.size());
+                        while (node.size() > lo_path[d].pos) {
+                            node.erase(lo_path[d].pos);
+                        }
+                    }
+                    if constexpr (has_inode_links) {
+                        node.set_next(hi_key ? hi_path[d].node : get_invalid_id());
+                    }
+                }
+                if (hi_key) {
+                    auto node = accessor.load_inode(hi_path[d].node);
+                    for (std::size_t i = 0; i < hi_path[d].pos; ++i) {
+                        erased += drop_entry_(node, 0);
+                        node.erase(0);
+                    }
+                }
+            }
+
+            if (both && (lo_leaf.self() == hi_leaf.self())) {
+                erased += erase_values_(lo_leaf, first.idx_, last.idx_);
+            }
+            else {
+                if (lo_key) {
+                    erased += erase_values_(lo_leaf, lo_leaf.key_position(lo), lo_leaf.size());
+                    lo_leaf.set_next(hi_key ? hi_leaf.self() : get_invalid_id());
+                }
+                if (hi_key) {
+                    erased += erase_values_(hi_leaf, 0, last.idx_);
+                    hi_leaf.set_prev(lo_key ? lo_leaf.self() : get_invalid_id());
+                    if (last.idx_ > 0) {
+                        fix_parent_index(hi_leaf);
+                    }
+                }
+            }
+            for (const auto& step : lo_path) {
+                counts_touched_(step.node);
+            }
+            for (const auto& step : hi_path) {
+                counts_touched_(step.node);
+            }
+
+            // both boundary leaves keep at least one element; merge or refill them and
+            // their parents as a single remove would
+            descent_path_.clear();
+            if (lo_key) {
+                handle_leaf_underflow(lo_leaf, lo);
+            }
+            if (hi_key) {
+                // the left side may have merged the leaf away
+                auto [node_id, pos, found] = find_node_with(model_.key_borrow_as_like(*hi_key));
+                handle_leaf_underflow(accessor.load_leaf(node_id), lo);
+            }
+            if (lo_key) {
+                settle_path_(model_.key_borrow_as_like(*lo_key));
+            }
+            if (hi_key) {
+                settle_path_(model_.key_borrow_as_like(*hi_key));
+            }
+            shrink_root_();
+            settle_counts_();
+            return erased;
+        }
+
         iterator find(key_like_type key) {
-            auto [nodeid, pos, found] = find_node_with(key);
+            auto [nodeid, pos, found] = find_node_with<true, true>(key);
             if (found) {
                 return iterator(this, nodeid, pos);
             }
@@ -356,6 +1076,230 @@ namespace fulla::bpt {
             }
         }
 
+        /// Looks up many keys at once; element i of the result is find(keys[i]).
+        /// The keys are resolved in sorted order: a key under the same inode as the one
+        /// before it resumes the descent from the deepest inode they share, and keys in
+        /// the same leaf skip the descent altogether.
+        std::vector<iterator> find_many(std::span<const key_like_type> keys) {
+            std::vector<iterator> result(keys.size(), end());
+            auto& accessor = get_accessor();
+            auto [root, exists] = accessor.load_root();
+            if (!exists) {
+                return result;
+            }
+            std::vector<std::size_t> order(keys.size());
+            std::iota(order.begin(), order.end(), std::size_t{ 0 });
+            std::ranges::stable_sort(order, [&](std::size_t a, std::size_t b) {
+                return model_.key_less(keys[a], keys[b]);
+            });
+
+            struct step {
+                inode_type node;
+                std::size_t pos = 0;
+            };
+            // the inodes of the last descent and the child taken in each
+            std::vector<step> path;
+            leaf_type leaf;
+            const auto descend = [&](node_id_type id, const key_like_type& key) {
+                while (!model_.is_leaf_id(id)) {
+                    auto inode = accessor.load_inode(id);
+                    DB_ASSERT(inode.is_valid(), "Something went wrong!");
+                    const auto pos = inode.key_position(key);
+                    id = inode.get_child(pos);
+                    path.push_back({ std::move(inode), pos });
+                }
+                leaf = accessor.load_leaf(id);
+            };
+
+            for (const auto idx : order) {
+                const auto& key = keys[idx];
+                // the keys come in ascending order, so a child still holds the key
+                // as long as the key stays below the child's upper separator
+                std::size_t keep = 0;
+                while ((keep < path.size()) && ((path[keep].pos == path[keep].node.size())
+                    || model_.key_less(key, model_.key_out_as_like(path[keep].node.get_key(path[keep].pos))))) {
+                    ++keep;
+                }
+                if (keep < path.size()) {
+                    path.resize(keep + 1);
+                    auto& last = path.back();
+                    last.pos = last.node.key_position(key);
+                    const auto child = last.node.get_child(last.pos);
+                    descend(child, key);
+                }
+                else if (!leaf.is_valid()) {
+                    descend(root, key);
+                }
+
+                std::size_t pos = 0;
+                bool found = false;
+                if constexpr (concepts::LeafFindKey<leaf_type, key_like_type>) {
+                    pos = leaf.find_key(key);
+                    found = (pos != leaf.size());
+                }
+                else {
+                    pos = leaf.key_position(key);
+                    found = (pos != leaf.size()) && leaf.keys_eq(model_.key_out_as_like(leaf.get_key(pos)), key);
+                }
+                if (found) {
+                    result[idx] = iterator(this, leaf.self(), pos);
+                }
+            }
+            return result;
+        }
+
+        /// First element whose key is not less than `key`.
+        iterator lower_bound(key_like_type key) {
+            auto [it, found] = lower_bound_(key);
+            return it;
+        }
+
+        /// First element whose key is greater than `key`.
+        iterator upper_bound(key_like_type key) {
+            auto [it, found] = lower_bound_(key);
+            return found ? ++it : it;
+        }
+
+        std::pair<iterator, iterator> equal_range(key_like_type key) {
+            auto [it, found] = lower_bound_(key);
+            if (found) {
+                return { it, std::next(it) };
+            }
+            return { it, it };
+        }
+
+        /// Elements with keys in [lo, hi).
+        std::ranges::subrange<iterator> range(key_like_type lo, key_like_type hi) {
+            if (!model_.key_less(lo, hi)) {
+                auto first = lower_bound(lo);
+                return { first, first };
+            }
+            return { lower_bound(lo), lower_bound(hi) };
+        }
+
+        /// Calls `fn(key_out_type, value_out_type)` for every element with a key in [lo, hi).
+        /// The range is cut at separator keys of the upper inode levels into disjoint parts
+        /// that up to `threads` threads scan with their own cursors, so `fn` runs concurrently
+        /// and in no particular order across parts. The tree must not change meanwhile.
+        /// Models without concepts::ModelConcurrentReads (reads through a buffer manager
+        /// are not thread-safe) scan the parts one after another on the calling thread.
+        /// If `fn` throws, the remaining parts are skipped and the first exception is
+        /// rethrown on the calling thread once every worker has stopped.
+        template <typename F>
+        void parallel_for_each(key_like_type lo, key_like_type hi, F&& fn,
+            std::size_t threads = std::thread::hardware_concurrency()) {
+            if (!model_.key_less(lo, hi)) {
+                return;
+            }
+            threads = std::max<std::size_t>(threads, 1);
+            // a few parts per thread even out subtrees of different sizes
+            auto bounds = partition_bounds_(lo, hi, threads * 4);
+            const auto parts = bounds.size() + 1;
+
+            const auto scan = [&](std::size_t part) {
+                const auto from = (part == 0) ? lo : model_.key_borrow_as_like(bounds[part - 1]);
+                const auto to = (part == bounds.size()) ? hi : model_.key_borrow_as_like(bounds[part]);
+                for (auto c = seek_cursor_(from); c; c.next()) {
+                    auto key = c.key();
+                    if (!model_.key_less(model_.key_out_as_like(key), to)) {
+                        break;
+                    }
+                    fn(std::move(key), c.value());
+                }
+            };
+
+            if constexpr (concepts::ModelConcurrentReads<model_type>) {
+                threads = std::min(threads, parts);
+                if (threads > 1) {
+                    std::atomic<std::size_t> next_part{ 0 };
+                    std::mutex failure_mtx;
+                    std::exception_ptr failure;
+                    const auto worker = [&]() {
+                        try {
+                            for (auto part = next_part++; part < parts; part = next_part++) {
+                                scan(part);
+                            }
+                        }
+                        catch (...) {
+                            next_part = parts;
+                            std::lock_guard<std::mutex> lck(failure_mtx);
+                            if (!failure) {
+                                failure = std::current_exception();
+                            }
+                        }
+                    };
+                    {
+                        std::vector<std::jthread> pool;
+                        pool.reserve(threads - 1);
+                        for (std::size_t i = 1; i < threads; ++i) {
+                            pool.emplace_back(worker);
+                        }
+                        worker();
+                    }
+                    if (failure) {
+                        std::rethrow_exception(failure);
+                    }
+                    return;
+                }
+            }
+            for (std::size_t part = 0; part < parts; ++part) {
+                scan(part);
+            }
+        }
+
+        // Order statistics. They need a model whose inodes keep child counts
+        // (concepts::InodeChildCounts) and cost one descent each.
+
+        /// Number of elements with keys less than `key`.
+        std::size_t rank(key_like_type key) requires has_child_counts {
+            auto& accessor = get_accessor();
+            auto [current_id, exists] = accessor.load_root();
+            if (!exists) {
+                return 0;
+            }
+            std::size_t result = 0;
+            while (!model_.is_leaf_id(current_id)) {
+                auto inode = accessor.load_inode(current_id);
+                DB_ASSERT(inode.is_valid(), "Something went wrong!");
+                const auto pos = inode.key_position(key);
+                for (std::size_t i = 0; i < pos; ++i) {
+                    result += inode.get_count(i);
+                }
+                current_id = inode.get_child(pos);
+            }
+            return result + accessor.load_leaf(current_id).key_position(key);
+        }
+
+        /// Number of elements with keys in [lo, hi).
+        std::size_t count(key_like_type lo, key_like_type hi) requires has_child_counts {
+            if (!model_.key_less(lo, hi)) {
+                return 0;
+            }
+            return rank(hi) - rank(lo);
+        }
+
+        /// The element at zero-based position `n` in key order; end() past the last one.
+        iterator nth(std::size_t n) requires has_child_counts {
+            auto& accessor = get_accessor();
+            auto [current_id, exists] = accessor.load_root();
+            if (!exists) {
+                return end();
+            }
+            while (!model_.is_leaf_id(current_id)) {
+                auto inode = accessor.load_inode(current_id);
+                DB_ASSERT(inode.is_valid(), "Something went wrong!");
+                std::size_t pos = 0;
+                while ((pos < inode.size()) && (n >= inode.get_count(pos))) {
+                    n -= inode.get_count(pos++);
+                }
+                current_id = inode.get_child(pos);
+            }
+            if (n < accessor.load_leaf(current_id).size()) {
+                return iterator(this, current_id, n);
+            }
+            return end();
+        }
+
         void dump() {
             auto [root, exists] = get_accessor().load_root();
             if (exists) {
@@ -386,10 +1330,10 @@ namespace fulla::bpt {
                 auto inode = accessor.load_inode(node);
 
                 if (leaf.is_valid()) {
-                    std::cout << std::format("<{} p:{} cap:{}>", model_.id_as_string(leaf.self()), model_.id_as_string(leaf.get_parent()), leaf.capacity());
+                    std::cout << std::format("<{} p:{} cap:{}>", model_.id_as_string(leaf.self()), model_.id_as_string(parent_of(leaf)), leaf.capacity());
                 }
                 else {
-                    std::cout << std::format("<{} p:{} cap:{}>", model_.id_as_string(inode.self()), model_.id_as_string(inode.get_parent()), inode.capacity());
+                    std::cout << std::format("<{} p:{} cap:{}>", model_.id_as_string(inode.self()), model_.id_as_string(parent_of(inode)), inode.capacity());
                 }
                 std::cout
                     << std::dec << " "
@@ -444,27 +1388,184 @@ namespace fulla::bpt {
         //private:
 
         bool remove_impl(leaf_type &node, std::size_t pos) {
-            auto& accessor = get_accessor();
             auto stored_key = node.borrow_key(pos);
+            release_value(node, pos);
             node.erase(pos);
+            adjust_counts_(node, -1);
             if (pos == 0 && (node.size() > 0)) {
                 fix_parent_index(node);
             }
             handle_leaf_underflow(node, model_.key_borrow_as_like(stored_key));
-            auto [root, _] = accessor.load_root();
-            const auto root_size = visit_node([](auto& r) { return r.size(); }, root);
-            if (root_size == 0) {
+            shrink_root_();
+            settle_counts_();
+            return true;
+        }
+
+        // Drops an empty root leaf and root inodes left with a single child.
+        void shrink_root_() {
+            auto& accessor = get_accessor();
+            while (true) {
+                auto [root, exists] = accessor.load_root();
+                if (!exists || (visit_node([](auto& r) { return r.size(); }, root) != 0)) {
+                    return;
+                }
                 if (!model_.is_leaf_id(root)) {
-                    // should be here?
                     auto root_node = get_accessor().load_inode(root);
-                    accessor.set_root(root_node.get_child(0));
+                    const auto next_root = root_node.get_child(0);
+                    accessor.set_root(next_root);
+                    link_parent_id(next_root, get_invalid_id());
+                    counts_dropped_(root);
+                    drop_node(root);
                 }
                 else {
                     accessor.set_root(get_invalid_id());
+                    drop_node(root);
+                    return;
                 }
-                accessor.destroy(root);
             }
-            return true;
+        }
+
+        // The edges trimmed by erase_range() and split_at(), and a root hung by join(), can
+        // keep a single entry or none, and a node fixed on the way up can give the child
+        // fixed before it the siblings it lacked. Walks the path to `key` top-down and
+        // merges or refills every underflowed node on it, starting over after every change.
+        void settle_path_(const key_like_type& key) {
+            auto& accessor = get_accessor();
+            for (bool changed = true; changed;) {
+                changed = false;
+                shrink_root_();
+                auto [id, exists] = accessor.load_root();
+                if (!exists) {
+                    return;
+                }
+                for (bool is_root = true; !changed; is_root = false) {
+                    if (model_.is_leaf_id(id)) {
+                        auto node = accessor.load_leaf(id);
+                        changed = !is_root && settle_node_(node);
+                        break;
+                    }
+                    auto node = accessor.load_inode(id);
+                    changed = !is_root && settle_node_(node);
+                    if (!changed) {
+                        id = node.get_child(node.key_position(key));
+                        remember_parent(id, node.self());
+                    }
+                }
+            }
+        }
+
+        // Merges an underflowed node with a sibling, or borrows from them until it is no
+        // longer underflowed or they have nothing to spare. Returns true if anything moved.
+        template <typename NodeT>
+        bool settle_node_(NodeT& node) {
+            if (!node.is_underflow()) {
+                return false;
+            }
+            if constexpr (std::is_same_v<NodeT, leaf_type>) {
+                if (try_merge_leaf(node).is_valid()) {
+                    return true;
+                }
+            }
+            else {
+                if (try_merge_inode(node).is_valid()) {
+                    return true;
+                }
+            }
+            bool moved = false;
+            while (node.is_underflow() && (borrow_from_right(node, 0) || borrow_from_left(node, 0))) {
+                moved = true;
+            }
+            return moved;
+        }
+
+        // Puts `child` right before or after `sibling` in the parent of `sibling`, with
+        // `key` between the two; makes room first as an insert does.
+        void attach_beside_(node_id_type sibling, const key_like_type& key, node_id_type child, bool before) {
+            auto& accessor = get_accessor();
+            const auto parent_of_sibling = [&]() {
+                return accessor.load_inode(visit_node([&](auto& n) { return parent_of(n); }, sibling));
+            };
+            auto parent = parent_of_sibling();
+            auto pos = find_child_index_in_parent(parent, sibling);
+            handle_inode_overflow_default(parent, pos, key, sibling, rp_);
+            parent = parent_of_sibling();
+            pos = find_child_index_in_parent(parent, sibling);
+            if (before) {
+                parent.insert_child(pos, key, child);
+            }
+            else {
+                parent.insert_child(pos, key, sibling);
+                parent.update_child(pos + 1, child);
+            }
+            link_parent_id(child, parent.self());
+            counts_touched_(parent.self());
+        }
+
+        // The hints and caches that would point into nodes handed to another tree.
+        void forget_hints_() {
+            start_operation_();
+            append_leaf_ = get_invalid_id();
+        }
+
+        // Descends to the leaf for `key`, recording every inode and the child taken.
+        node_id_type descend_steps_(const key_like_type& key, std::vector<path_step>& path) {
+            auto& accessor = get_accessor();
+            auto [current, _] = accessor.load_root();
+            path.clear();
+            while (!model_.is_leaf_id(current)) {
+                auto inode = accessor.load_inode(current);
+                const auto pos = inode.key_position(key);
+                path.push_back({ current, pos });
+                const auto child = inode.get_child(pos);
+                remember_parent(child, current);
+                current = child;
+            }
+            return current;
+        }
+
+        // Erases the elements [from, to) of `leaf`, back to front, releasing their values.
+        std::size_t erase_values_(leaf_type& leaf, std::size_t from, std::size_t to) {
+            for (auto pos = to; pos > from; --pos) {
+                release_value(leaf, pos - 1);
+                leaf.erase(pos - 1);
+            }
+            return to - from;
+        }
+
+        // Destroys the subtree under child `pos` of `parent` and returns the number of
+        // elements it held. The entry itself stays in `parent`.
+        std::size_t drop_entry_(inode_type& parent, std::size_t pos) {
+            const auto child = parent.get_child(pos);
+            if constexpr (has_child_counts && !concepts::LeafReleaseValue<leaf_type>) {
+                if (model_.is_leaf_id(child)) {
+                    drop_node(child);
+                    return parent.get_count(pos);
+                }
+            }
+            return drop_subtree_(child);
+        }
+
+        std::size_t drop_subtree_(node_id_type id) {
+            auto& accessor = get_accessor();
+            std::size_t dropped = 0;
+            if (model_.is_leaf_id(id)) {
+                auto leaf = accessor.load_leaf(id);
+                dropped = leaf.size();
+                if constexpr (concepts::LeafReleaseValue<leaf_type>) {
+                    for (std::size_t i = 0; i < dropped; ++i) {
+                        release_value(leaf, i);
+                    }
+                }
+            }
+            else {
+                auto inode = accessor.load_inode(id);
+                for (std::size_t i = 0; i <= inode.size(); ++i) {
+                    dropped += drop_entry_(inode, i);
+                }
+                counts_dropped_(id);
+            }
+            drop_node(id);
+            return dropped;
         }
 
         struct split_leaf_result {
@@ -492,18 +1593,22 @@ namespace fulla::bpt {
             if (right.is_valid()) {
                 auto key = node.borrow_key(middle_element);
 
-                right.set_parent(node.get_parent());
+                link_parent(right, parent_of(node));
+                if constexpr (has_inode_links) {
+                    right.set_next(node.get_next());
+                    node.set_next(right.self());
+                }
 
                 for (std::size_t id = middle_element + 1; id < node.size(); ++id) {
                     auto borrow_key = node.borrow_key(id);
                     auto next_child = node.get_child(id);
-                    visit_node([&](auto& cnode) { cnode.set_parent(right.self()); }, next_child);
+                    link_parent_id(next_child, right.self());
                     right.insert_child(right.size(), model_.key_borrow_as_like(borrow_key), next_child);
                 }
 
                 // latest child 
                 auto last_child = node.get_child(node.size());
-                visit_node([&](auto& cnode) { cnode.set_parent(right.self()); }, last_child);
+                link_parent_id(last_child, right.self());
                 right.update_child(right.size(), last_child);
 
                 for (std::size_t i = 0; i < reduce_size; ++i) {
@@ -539,7 +1644,7 @@ namespace fulla::bpt {
 
                     right.insert_value(last_element, id_like, std::move(val_in));
                 }
-                right.set_parent(node.get_parent());
+                link_parent(right, parent_of(node));
 
                 right.set_prev(node_id);
                 right.set_next(node.get_next());
@@ -572,12 +1677,8 @@ namespace fulla::bpt {
         void handle_leaf_overflow_default(leaf_type& node, const key_like_type& key, 
             value_in_type value, std::size_t pos, policies::rebalance rp) {
             auto res_node = handle_leaf_overflow(node, rp);
-            if (node.size() < pos) {
-                const auto insert_pos = pos - node.size();
-                res_node.insert_value(insert_pos, key, std::move(value));
-                if (insert_pos == 0) {
-                    fix_parent_index(res_node);
-                }
+            if ((node.size() < pos) || ((node.size() == pos) && !below_separator(res_node, key))) {
+                res_node.insert_value(pos - node.size(), key, std::move(value));
             }
             else {
                 node.insert_value(pos, key, std::move(value));
@@ -587,64 +1688,164 @@ namespace fulla::bpt {
             }
         }
 
+        // The key promoted into the parent between two neighbouring nodes: a truncated
+        // separator if the model can build one, otherwise the first key of the right node.
+        auto make_separator(const key_like_type& left_last, const key_like_type& right_first) {
+            if constexpr (concepts::ModelSeparator<model_type>) {
+                return model_.make_separator(left_last, right_first);
+            }
+            else {
+                return right_first;
+            }
+        }
+
+        auto leaf_separator(const leaf_type& left, const leaf_type& right) {
+            return make_separator(model_.key_out_as_like(left.get_key(left.size() - 1)),
+                model_.key_out_as_like(right.get_key(0)));
+        }
+
+        // A key that sorts between two freshly split leaves belongs to the left one
+        // unless it reaches the (possibly truncated) separator promoted for `right`.
+        bool below_separator(const leaf_type& right, const key_like_type& key) {
+            if constexpr (concepts::ModelSeparator<model_type>) {
+                auto parent = get_accessor().load_inode(parent_of(right));
+                const auto pos = find_child_index_in_parent(parent, right.self());
+                DB_ASSERT(pos != npos && pos > 0, "the right half of a split must have a left neighbour");
+                return model_.key_less(key, model_.key_out_as_like(parent.get_key(pos - 1)));
+            }
+            else {
+                return true;
+            }
+        }
+
+        template <typename SeparatorT>
+        key_like_type separator_as_like(SeparatorT& separator) {
+            if constexpr (concepts::ModelSeparator<model_type>) {
+                return model_.key_borrow_as_like(separator);
+            }
+            else {
+                return separator;
+            }
+        }
+
         leaf_type handle_leaf_overflow(leaf_type& node, policies::rebalance rp) {
 
-            const auto node_id = node.self();
             auto& accessor = get_accessor();
 
             inode_type new_root{};
-            if (!model_.is_valid_id(node.get_parent())) { // node is root_?
+            if (!model_.is_valid_id(parent_of(node))) { // node is root_?
                 new_root = accessor.create_inode();
             }
             if (auto split_right = split_leaf(node)) {
                 auto&& [right, key] = split_right;
+                attach_right_leaf(node, right, new_root, rp);
+                return right;
+            }
+            return {};
+        }
 
-                if (new_root.is_valid()) { // node is root_;
-                    const auto first_like = model_.key_out_as_like(right.get_key(0));
-                    right.set_parent(new_root.self());
+        // Puts the separator of `node` and its new right neighbour into the parent,
+        // growing a new root (`new_root`, created beforehand) if `node` was the root.
+        void attach_right_leaf(leaf_type& node, leaf_type& right, inode_type& new_root, policies::rebalance rp) {
 
-                    auto [current_root, exists] = accessor.load_root();
-                    visit_node([&](auto& c) { c.set_parent(new_root.self()); }, current_root);
+            const auto node_id = node.self();
+            auto& accessor = get_accessor();
+            auto separator = leaf_separator(node, right);
 
-                    new_root.insert_child(0, first_like, current_root);
-                    new_root.update_child(1, right.self());
+            if (new_root.is_valid()) { // node is root_;
+                const auto first_like = separator_as_like(separator);
+                link_parent(right, new_root.self());
 
-                    accessor.set_root(new_root.self());
+                auto [current_root, exists] = accessor.load_root();
+                link_parent_id(current_root, new_root.self());
 
-                    return right;
-                }
-                else {
-                    auto parent_id = node.get_parent();
-                    auto pos = find_child_index_in_parent(parent_id, node_id);
-                    auto parent = accessor.load_inode(parent_id);
-                    auto pos_child = parent.get_child(pos);
+                new_root.insert_child(0, first_like, current_root);
+                new_root.update_child(1, right.self());
+
+                accessor.set_root(new_root.self());
+                counts_touched_(new_root.self());
+            }
+            else {
+                auto parent_id = parent_of(node);
+                auto pos = find_child_index_in_parent(parent_id, node_id);
+                auto parent = accessor.load_inode(parent_id);
+                auto pos_child = parent.get_child(pos);
 
-                    handle_inode_overflow_default(parent, pos, model_.key_out_as_like(key), pos_child, rp);
+                handle_inode_overflow_default(parent, pos, separator_as_like(separator), pos_child, rp);
 
-                    parent_id = node.get_parent();
-                    pos = find_child_index_in_parent(parent_id, node_id);
+                parent_id = parent_of(node);
+                pos = find_child_index_in_parent(parent_id, node_id);
 
-                    parent = accessor.load_inode(parent_id);
+                parent = accessor.load_inode(parent_id);
 
-                    right.set_parent(parent_id);
+                link_parent(right, parent_id);
 
-                    const auto first_like = model_.key_out_as_like(right.get_key(0));
-                    pos_child = parent.get_child(pos);
+                const auto first_like = separator_as_like(separator);
+                pos_child = parent.get_child(pos);
 
-                    parent.insert_child(pos, first_like, pos_child); // insert the same child
-                    parent.update_child(pos + 1, right.self()); // update shifted
+                parent.insert_child(pos, first_like, pos_child); // insert the same child
+                parent.update_child(pos + 1, right.self()); // update shifted
+                counts_touched_(parent_id);
+            }
+        }
 
-                    return right;
-                }
+        // The remembered rightmost leaf, if `key` goes after all of its keys.
+        leaf_type load_append_leaf(const key_like_type& key) {
+            if (!model_.is_valid_id(append_leaf_)) {
+                return {};
             }
+            auto leaf = get_accessor().load_leaf(append_leaf_);
+            if (leaf.is_valid() && (leaf.size() > 0) && !model_.is_valid_id(leaf.get_next())
+                && model_.key_less(model_.key_out_as_like(leaf.get_key(leaf.size() - 1)), key)) {
+                return leaf;
+            }
+            append_leaf_ = get_invalid_id();
             return {};
         }
 
+        // Append mode: `key` goes after every key of the rightmost leaf `node`. A full
+        // leaf is not split; the key starts a new rightmost leaf of its own.
+        // Returns false, with the tree unchanged, if the new nodes can't be allocated.
+        bool append_value(leaf_type& node, const key_like_type& key, value_in_type value) {
+            auto& accessor = get_accessor();
+            if (node.can_insert_value(node.size(), key, value)) {
+                node.insert_value(node.size(), key, std::move(value));
+                adjust_counts_(node, 1);
+                append_leaf_ = node.self();
+                return true;
+            }
+
+            inode_type new_root{};
+            if (!model_.is_valid_id(parent_of(node))) {
+                new_root = accessor.create_inode();
+                if (!new_root.is_valid()) {
+                    return false;
+                }
+            }
+            auto right = accessor.create_leaf();
+            if (!right.is_valid()) {
+                if (new_root.is_valid()) {
+                    const auto id = new_root.self();
+                    new_root = {};
+                    drop_node(id);
+                }
+                return false;
+            }
+            right.insert_value(0, key, std::move(value));
+            link_parent(right, parent_of(node));
+            right.set_prev(node.self());
+            node.set_next(right.self());
+            attach_right_leaf(node, right, new_root, rp_);
+            append_leaf_ = right.self();
+            settle_counts_();
+            return true;
+        }
+
         inode_type handle_inode_overflow(inode_type& node, policies::rebalance rp) {
 
             auto& accessor = get_accessor();
             inode_type new_root;
-            if (!model_.is_valid_id(node.get_parent())) { // is node root_?
+            if (!model_.is_valid_id(parent_of(node))) { // is node root_?
                 new_root = accessor.create_inode();
             }
             auto [root_id, exists] = accessor.load_root();
@@ -655,28 +1856,32 @@ namespace fulla::bpt {
                     new_root.insert_child(0, model_.key_borrow_as_like(key), root_id);
                     new_root.update_child(1, right.self());
 
-                    visit_node([&](auto& c) { c.set_parent(new_root.self()); }, new_root.get_child(0));
-                    visit_node([&](auto& c) { c.set_parent(new_root.self()); }, new_root.get_child(1));
+                    link_parent_id(new_root.get_child(0), new_root.self());
+                    link_parent_id(new_root.get_child(1), new_root.self());
 
                     accessor.set_root(new_root.self());
+                    counts_touched_(new_root.self());
                 }
                 else {
-                    auto parent = node.get_parent();
+                    auto parent = parent_of(node);
                     auto pos = find_child_index_in_parent(parent, node.self());
                     auto pnode = accessor.load_inode(parent);
                     auto pos_child = pnode.get_child(pos);
 
                     handle_inode_overflow_default(pnode, pos, model_.key_borrow_as_like(key), pos_child, rp);
 
-                    parent = node.get_parent();
-                    right.set_parent(parent);
+                    parent = parent_of(node);
+                    link_parent(right, parent);
                     pos = find_child_index_in_parent(parent, node.self());
                     pnode = accessor.load_inode(parent);
 
                     pos_child = pnode.get_child(pos);
                     pnode.insert_child(pos, model_.key_borrow_as_like(key), pos_child);
                     pnode.update_child(pos + 1, right.self());
+                    counts_touched_(parent);
                 }
+                counts_touched_(node.self());
+                counts_touched_(right.self());
                 return right;
             }
             return {};
@@ -698,10 +1903,11 @@ namespace fulla::bpt {
 
             const auto pos = node.key_position(key);
             if (pos > 0 && (pos <= node.size())) {
-                const auto out_like = model_.key_out_as_like(node.get_key(pos - 1));
-                if (node.keys_eq(key, out_like)) {
+                const auto out_key = node.get_key(pos - 1);
+                if (node.keys_eq(key, model_.key_out_as_like(out_key))) {
                     const auto first_leaf = accessor.load_leaf(get_leftmost_leaf(node.get_child(pos)));
-                    const auto first_like = model_.key_out_as_like(first_leaf.get_key(0));
+                    const auto first_key = first_leaf.get_key(0);
+                    const auto first_like = model_.key_out_as_like(first_key);
                     // !TODO: check for overflow here
                     //node.update_key(pos - 1, first_like);
                     update_inode_key(node, pos - 1, first_like);
@@ -715,7 +1921,7 @@ namespace fulla::bpt {
                 borrow_from_right(node, 0) || borrow_from_left(node, 0);
             }
 
-            auto parent = accessor.load_inode(node.get_parent());
+            auto parent = accessor.load_inode(parent_of(node));
             if (parent.is_valid()) {
                 handle_inode_underflow(parent, key);
                 fix_zero_root(parent);
@@ -731,7 +1937,7 @@ namespace fulla::bpt {
             else if (node.is_underflow()) {
                 borrow_from_right(node, 0) || borrow_from_left(node, 0);
             }
-            auto parent = get_accessor().load_inode(node.get_parent());
+            auto parent = get_accessor().load_inode(parent_of(node));
             if (parent.is_valid()) {
                 handle_inode_underflow(parent, key);
                 fix_zero_root(parent);
@@ -742,14 +1948,15 @@ namespace fulla::bpt {
         void fix_zero_root(inode_type& node) {
             auto& accessor = get_accessor();
             if (node.size() == 0) {
-                if (!model_.is_valid_id(node.get_parent())) {
+                if (!model_.is_valid_id(parent_of(node))) {
                     auto [root, _] = accessor.load_root();
                     auto proot = accessor.load_inode(root);
                     auto next_child = proot.get_child(0);
-                    accessor.destroy(root);
+                    counts_dropped_(root);
+                    drop_node(root);
                     accessor.set_root(next_child);
                     if (model_.is_valid_id(next_child)) {
-                        visit_node([&](auto& c) { c.set_parent(get_invalid_id()); }, next_child);
+                        link_parent_id(next_child, get_invalid_id());
                     }
                 }
             }
@@ -774,7 +1981,7 @@ namespace fulla::bpt {
             if (left.size() > (min_elements + additional_elements)) {
 
                 const auto key_to_check = left.get_key(left.size() - 1);
-                auto parent = get_accessor().load_inode(node.get_parent());
+                auto parent = get_accessor().load_inode(parent_of(node));
                 auto pos = find_child_index_in_parent(parent, node.self());
 
                 // TODO: check if it's possible to split the parent here.
@@ -794,7 +2001,9 @@ namespace fulla::bpt {
                     // TODO: check for overflow here
                     // TODO: check if its possible to reuse 'key' here 
                     //update_parent_inode_key(parent, pos - 1, node);
-                    parent.update_key(pos - 1, model_.key_out_as_like(node.get_key(0)));
+                    auto separator = leaf_separator(left, node);
+                    parent.update_key(pos - 1, separator_as_like(separator));
+                    counts_touched_(parent.self());
                     return true;
                 }
             }
@@ -817,7 +2026,7 @@ namespace fulla::bpt {
             if (right.size() > (min_elements + additional_elements)) {
 
                 auto right_second_key = right.get_key(1);
-                auto parent = get_accessor().load_inode(node.get_parent());
+                auto parent = get_accessor().load_inode(parent_of(node));
                 auto pos = find_child_index_in_parent(parent, node.self());
 
                 // TODO: check if it's possible to split the parent here.
@@ -834,7 +2043,9 @@ namespace fulla::bpt {
                     right.erase(0);
                     // TODO: check for overflow here
                     //update_parent_inode_key(parent, pos, right);
-                    parent.update_key(pos, model_.key_out_as_like(right.get_key(0)));
+                    auto separator = leaf_separator(node, right);
+                    parent.update_key(pos, separator_as_like(separator));
+                    counts_touched_(parent.self());
 
                     return true;
                 }
@@ -856,7 +2067,7 @@ namespace fulla::bpt {
             if (give_to_left<leaf_type>(node, first ? 1 : 0, rp)) {
                 if (first) {
                     auto left_sibling = accessor.load_leaf(find_left_sibling(node));
-                    left_sibling.insert_value(left_sibling.size(), key, std::move(value));
+                    left_sibling.insert_value(left_sibling.key_position(key), key, std::move(value));
                 }
                 else {
                     pos--;
@@ -879,6 +2090,13 @@ namespace fulla::bpt {
                     right_sibling.insert_value(pos, key, std::move(value));
                     fix_parent_index(right_sibling);
                 }
+                else if ((pos == node.size()) && !below_separator(accessor.load_leaf(find_right_sibling(node)), key)) {
+                    auto right_sibling = accessor.load_leaf(find_right_sibling(node));
+                    if (!right_sibling.can_insert_value(0, key, value)) {
+                        return false;
+                    }
+                    right_sibling.insert_value(0, key, std::move(value));
+                }
                 else {
                     if (node.can_insert_value(pos, key, value)) {
                         node.insert_value(pos, key, std::move(value));
@@ -910,7 +2128,7 @@ namespace fulla::bpt {
 
             if (left.size() > (min_elements + additional_elements)) {
 
-                auto parent = get_accessor().load_inode(node.get_parent());
+                auto parent = get_accessor().load_inode(parent_of(node));
                 const auto pos = find_child_index_in_parent(parent, node.self());
 
                 auto borrow_parent_key = parent.borrow_key(pos - 1);
@@ -920,7 +2138,7 @@ namespace fulla::bpt {
                 auto key = model_.key_borrow_as_like(borrow_key);
                 auto child = std::move(left.get_child(left.size()));
 
-                visit_node([&](auto& c) { c.set_parent(node.self()); }, child);
+                link_parent_id(child, node.self());
 
                 const auto last_key = left.size() - 1;
 
@@ -935,6 +2153,9 @@ namespace fulla::bpt {
                 swap_children(left, left.size() - 1, left.size());
                 left.erase(last_key);
 
+                counts_touched_(node.self());
+                counts_touched_(left.self());
+                counts_touched_(parent_of(node));
                 return true;
             }
             return false;
@@ -955,7 +2176,7 @@ namespace fulla::bpt {
 
             if (right.size() > (min_elements + additional_elements)) {
 
-                auto parent = get_accessor().load_inode(node.get_parent());
+                auto parent = get_accessor().load_inode(parent_of(node));
                 const auto pos = find_child_index_in_parent(parent, node.self());
 
                 assert(pos != npos && "Something went wrong. pos == npos");
@@ -967,7 +2188,7 @@ namespace fulla::bpt {
                 auto key = model_.key_borrow_as_like(borrow_key);
                 auto child = std::move(right.get_child(0));
 
-                visit_node([&](auto& c) { c.set_parent(node.self()); }, child);
+                link_parent_id(child, node.self());
 
                 // !TODO: check for overflow here
                 // always replace
@@ -981,6 +2202,9 @@ namespace fulla::bpt {
 
                 right.erase(0);
 
+                counts_touched_(node.self());
+                counts_touched_(right.self());
+                counts_touched_(parent_of(node));
                 return true;
             }
             return false;
@@ -1036,7 +2260,7 @@ namespace fulla::bpt {
 
             if (rp == policies::rebalance::local_rebalance) {
 
-                auto parent = get_accessor().load_inode(node.get_parent());
+                auto parent = get_accessor().load_inode(parent_of(node));
                 const auto pos = find_child_index_in_parent(parent, node.self());
 
                 bool res = false;
@@ -1095,7 +2319,7 @@ namespace fulla::bpt {
 
             if (rp == policies::rebalance::local_rebalance) {
 
-                auto parent = get_accessor().load_inode(node.get_parent());
+                auto parent = get_accessor().load_inode(parent_of(node));
 
                 auto pos = find_child_index_in_parent(parent, node.self());
                 bool res = false;
@@ -1158,7 +2382,7 @@ namespace fulla::bpt {
             if (right.is_valid()) {
                 if (get_accessor().can_merge_leafs(node, right)) {
 
-                    auto parent = accessor.load_inode(node.get_parent());
+                    auto parent = accessor.load_inode(parent_of(node));
                     const auto right_pos = find_child_index_in_parent(parent, right.self());
 
                     for (std::size_t id = 0; id < right.size(); ++id) {
@@ -1182,8 +2406,9 @@ namespace fulla::bpt {
 
                     swap_children(parent, right_pos - 1, right_pos);
 
-                    accessor.destroy(parent.get_child(right_pos - 1));
+                    drop_node(parent.get_child(right_pos - 1));
                     parent.erase(right_pos - 1);
+                    counts_touched_(parent.self());
                     return node;
                 }
             }
@@ -1213,7 +2438,7 @@ namespace fulla::bpt {
             if (right.is_valid()) {
                 if (get_accessor().can_merge_inodes(node, right)) {
 
-                    auto parent = accessor.load_inode(node.get_parent());
+                    auto parent = accessor.load_inode(parent_of(node));
                     auto right_pos = find_child_index_in_parent(parent, right.self());
 
                     auto borrow_separator = parent.borrow_key(right_pos - 1);
@@ -1228,20 +2453,26 @@ namespace fulla::bpt {
                         auto borrow_key = right.borrow_key(id);
                         auto id_like = model_.key_borrow_as_like(borrow_key);
                         const auto child = right.get_child(id);
-                        visit_node([&node](auto& c) { c.set_parent(node.self()); }, child);
+                        link_parent_id(child, node.self());
 
                         node.insert_child(node.size(), std::move(id_like), child);
                     }
 
                     // update the latest child
                     const auto last_child = right.get_child(right.size()); // last
-                    visit_node([&node](auto& c) { c.set_parent(node.self()); }, last_child);
+                    link_parent_id(last_child, node.self());
                     node.update_child(node.size(), last_child); 
+                    if constexpr (has_inode_links) {
+                        node.set_next(right.get_next());
+                    }
 
                     swap_children(parent, right_pos - 1, right_pos);
 
-                    accessor.destroy(parent.get_child(right_pos - 1));
+                    counts_dropped_(right.self());
+                    drop_node(parent.get_child(right_pos - 1));
                     parent.erase(right_pos - 1);
+                    counts_touched_(node.self());
+                    counts_touched_(parent.self());
                     return node;
                 }
             }
@@ -1267,6 +2498,389 @@ namespace fulla::bpt {
         //endregion merging
 #pragma endregion "merging"
 
+#pragma region "bulk loading"
+        //region bulk loading
+
+        template <typename NodeT>
+        static bool bulk_fill_reached(const NodeT& node, double fill_factor) {
+            if constexpr (concepts::NodeFillRatio<NodeT>) {
+                return node.fill_ratio() >= fill_factor;
+            }
+            else {
+                const auto limit = static_cast<std::size_t>(static_cast<double>(node.capacity()) * fill_factor);
+                return node.size() >= std::max<std::size_t>(limit, 1);
+            }
+        }
+
+        // Appends an element to the right edge of the tree being built. `leaf` is the current
+        // last leaf (invalid before the first element); a new one is opened when it is full
+        // or has reached `fill_factor`.
+        // Every node it allocates is recorded in `created`, so a failed build can be undone
+        // with bulk_abort().
+        bool bulk_append_value(std::vector<inode_type>& open_inodes, leaf_type& leaf,
+            std::vector<node_id_type>& created, const key_like_type& key, value_in_type value, double fill_factor) {
+
+            auto& accessor = get_accessor();
+            if (!leaf.is_valid()) {
+                leaf = accessor.create_leaf();
+                if (!leaf.is_valid()) {
+                    return false;
+                }
+                created.push_back(leaf.self());
+            }
+            else if (!leaf.can_insert_value(leaf.size(), key, value) || bulk_fill_reached(leaf, fill_factor)) {
+                auto next = accessor.create_leaf();
+                if (!next.is_valid()) {
+                    return false;
+                }
+                created.push_back(next.self());
+                DB_ASSERT(leaf.key_position(key) == leaf.size(), "bulk_load input must be sorted");
+                leaf.set_next(next.self());
+                next.set_prev(leaf.self());
+                auto separator = make_separator(model_.key_out_as_like(leaf.get_key(leaf.size() - 1)), key);
+                const auto parent_id = bulk_attach_child(open_inodes, created, 0, separator_as_like(separator),
+                    next.self(), leaf.self(), fill_factor);
+                if (!model_.is_valid_id(parent_id)) {
+                    return false;
+                }
+                link_parent(next, parent_id);
+                leaf = std::move(next);
+            }
+            leaf.insert_value(leaf.size(), key, std::move(value));
+            return true;
+        }
+
+        // Makes the built tree the current one once the last element is in.
+        void bulk_finish(std::vector<inode_type>& open_inodes, leaf_type& leaf) {
+            get_accessor().set_root(open_inodes.empty() ? leaf.self() : open_inodes.back().self());
+
+            open_inodes.clear();
+            leaf = {};
+
+            // only the right edge can be under-filled; even it out with the left neighbours.
+            // The walk goes top-down and starts over after every change: a fresh inode holding
+            // just the last leaf gives that leaf no left sibling until the inode is fixed, and
+            // a merge can leave the parent under-filled in turn.
+            auto& accessor = get_accessor();
+            for (bool changed = true; changed;) {
+                changed = false;
+                auto [id, exists] = accessor.load_root();
+                if (!model_.is_leaf_id(id)) {
+                    auto root = accessor.load_inode(id);
+                    fix_zero_root(root);
+                    id = std::get<0>(accessor.load_root());
+                }
+                for (bool is_root = true; !changed; is_root = false) {
+                    if (model_.is_leaf_id(id)) {
+                        auto node = accessor.load_leaf(id);
+                        changed = !is_root && bulk_settle_edge_node(node);
+                        break;
+                    }
+                    auto node = accessor.load_inode(id);
+                    changed = !is_root && bulk_settle_edge_node(node);
+                    if (!changed) {
+                        id = node.get_child(node.size());
+                        remember_parent(id, node.self());
+                    }
+                }
+            }
+            recount_all_();
+            counts_dirty_.clear();
+            // the links learned while building cover every node; drop them
+            start_operation_();
+        }
+
+        // Fills an under-filled node on the right edge from its left neighbour: merges into it
+        // when both fit in one node, otherwise borrows until the node is no longer underflowed
+        // or the neighbour has nothing to spare. Returns true if anything moved.
+        template <typename NodeT>
+        bool bulk_settle_edge_node(NodeT& node) {
+            if (!node.is_underflow()) {
+                return false;
+            }
+            if constexpr (std::is_same_v<NodeT, leaf_type>) {
+                if (merge_leaf_with_left(node).is_valid()) {
+                    return true;
+                }
+            }
+            else {
+                if (merge_inode_with_left(node).is_valid()) {
+                    return true;
+                }
+            }
+            bool moved = false;
+            while (node.is_underflow() && borrow_from_left(node, 0)) {
+                moved = true;
+            }
+            return moved;
+        }
+
+        // Destroys the nodes (and the values they own) of a build that could not be completed.
+        void bulk_abort(std::vector<inode_type>& open_inodes, leaf_type& leaf, const std::vector<node_id_type>& created) {
+            auto& accessor = get_accessor();
+            open_inodes.clear();
+            leaf = {};
+            for (auto id : created) {
+                if (model_.is_leaf_id(id)) {
+                    auto built = accessor.load_leaf(id);
+                    for (std::size_t i = 0; i < built.size(); ++i) {
+                        release_value(built, i);
+                    }
+                }
+                drop_node(id);
+            }
+        }
+
+        template <typename NodeT>
+        static double leaf_fill(const NodeT& node) {
+            if constexpr (concepts::NodeFillRatio<NodeT>) {
+                return node.fill_ratio();
+            }
+            else {
+                return static_cast<double>(node.size()) / static_cast<double>(std::max<std::size_t>(node.capacity(), 1));
+            }
+        }
+
+        static bool ahead_in_storage(node_id_type id, node_id_type next) {
+            if constexpr (std::integral<node_id_type>) {
+                return next > id;
+            }
+            else {
+                return true;
+            }
+        }
+
+        // Appends `child` (whose first key is `key`) to the rightmost inode on `level`.
+        // `left` is the node that precedes `child` on the same level. Returns the id of the inode
+        // that received the child.
+        node_id_type bulk_attach_child(std::vector<inode_type>& open_inodes, std::vector<node_id_type>& created,
+            std::size_t level, const key_like_type& key, node_id_type child, node_id_type left, double fill_factor) {
+
+            auto& accessor = get_accessor();
+            if (level == open_inodes.size()) {
+                auto parent = accessor.create_inode();
+                if (!parent.is_valid()) {
+                    return get_invalid_id();
+                }
+                created.push_back(parent.self());
+                parent.update_child(0, left);
+                link_parent_id(left, parent.self());
+                open_inodes.emplace_back(std::move(parent));
+            }
+
+            auto& parent = open_inodes[level];
+            if (bulk_fill_reached(parent, fill_factor) || !parent.can_insert_child(parent.size(), key, child)) {
+                auto sibling = accessor.create_inode();
+                if (!sibling.is_valid()) {
+                    return get_invalid_id();
+                }
+                created.push_back(sibling.self());
+                sibling.update_child(0, child);
+                if constexpr (has_inode_links) {
+                    parent.set_next(sibling.self());
+                }
+                const auto sibling_parent = bulk_attach_child(open_inodes, created, level + 1, key,
+                    sibling.self(), open_inodes[level].self(), fill_factor);
+                if (!model_.is_valid_id(sibling_parent)) {
+                    return get_invalid_id();
+                }
+                link_parent(sibling, sibling_parent);
+                open_inodes[level] = std::move(sibling);
+                return open_inodes[level].self();
+            }
+
+            const auto last_child = parent.get_child(parent.size());
+            parent.insert_child(parent.size(), key, last_child);
+            parent.update_child(parent.size(), child);
+            return parent.self();
+        }
+
+        //endregion bulk loading
+#pragma endregion "bulk loading"
+
+#pragma region "order statistics"
+        //region order statistics
+
+        // With concepts::InodeChildCounts every inode entry holds the number of elements
+        // under its child. A plain insert or remove adjusts the entries on the way to the
+        // root. Splits, merges and borrows only mark the inodes whose children changed
+        // (counts_dirty_); settle_counts_() recounts them when the operation is done.
+
+        std::size_t subtree_count_(node_id_type id) {
+            auto& accessor = get_accessor();
+            if (model_.is_leaf_id(id)) {
+                return accessor.load_leaf(id).size();
+            }
+            return children_count_(accessor.load_inode(id));
+        }
+
+        std::size_t children_count_(const inode_type& inode) {
+            std::size_t result = 0;
+            if constexpr (has_child_counts) {
+                for (std::size_t i = 0; i <= inode.size(); ++i) {
+                    result += inode.get_count(i);
+                }
+            }
+            return result;
+        }
+
+        std::size_t total_count_() {
+            auto [root, exists] = get_accessor().load_root();
+            return exists ? subtree_count_(root) : 0;
+        }
+
+        void adjust_counts_(leaf_type& leaf, std::ptrdiff_t delta) {
+            if constexpr (has_child_counts) {
+                auto& accessor = get_accessor();
+                auto child = leaf.self();
+                auto parent = accessor.load_inode(parent_of(leaf));
+                while (parent.is_valid()) {
+                    const auto pos = find_child_index_in_parent(parent, child);
+                    DB_ASSERT(pos != npos, "child is not found in its parent");
+                    parent.set_count(pos, static_cast<std::size_t>(static_cast<std::ptrdiff_t>(parent.get_count(pos)) + delta));
+                    child = parent.self();
+                    const auto next = parent_of(parent);
+                    parent = accessor.load_inode(next);
+                }
+            }
+        }
+
+        void counts_touched_(node_id_type id) {
+            if constexpr (has_child_counts) {
+                if (model_.is_valid_id(id) && (std::ranges::find(counts_dirty_, id) == counts_dirty_.end())) {
+                    counts_dirty_.push_back(id);
+                }
+            }
+        }
+
+        void counts_dropped_(node_id_type id) {
+            if constexpr (has_child_counts) {
+                std::erase(counts_dirty_, id);
+            }
+        }
+
+        // Deepest inodes first, so every child is settled before its parent sums it up;
+        // the ancestors of each recounted inode get its new total.
+        void settle_counts_() {
+            if constexpr (has_child_counts) {
+                auto& accessor = get_accessor();
+                std::vector<std::pair<std::size_t, node_id_type>> order;
+                for (auto id : counts_dirty_) {
+                    auto node = accessor.load_inode(id);
+                    if (node.is_valid()) {
+                        std::size_t depth = 0;
+                        for (auto up = parent_of(node); model_.is_valid_id(up); ++depth) {
+                            auto upper = accessor.load_inode(up);
+                            up = parent_of(upper);
+                        }
+                        order.emplace_back(depth, id);
+                    }
+                }
+                counts_dirty_.clear();
+                std::ranges::stable_sort(order, std::ranges::greater{}, [](const auto& p) { return p.first; });
+
+                for (auto& [depth, id] : order) {
+                    auto node = accessor.load_inode(id);
+                    for (std::size_t i = 0; i <= node.size(); ++i) {
+                        node.set_count(i, subtree_count_(node.get_child(i)));
+                    }
+                    auto total = children_count_(node);
+                    auto child = node.self();
+                    auto parent = accessor.load_inode(parent_of(node));
+                    while (parent.is_valid()) {
+                        const auto pos = find_child_index_in_parent(parent, child);
+                        DB_ASSERT(pos != npos, "child is not found in its parent");
+                        parent.set_count(pos, total);
+                        total = children_count_(parent);
+                        child = parent.self();
+                        const auto next = parent_of(parent);
+                        parent = accessor.load_inode(next);
+                    }
+                }
+            }
+        }
+
+        // Recounts the whole tree bottom-up (after bulk_load).
+        std::size_t recount_all_() {
+            if constexpr (has_child_counts) {
+                auto [root, exists] = get_accessor().load_root();
+                return exists ? recount_subtree_(root) : 0;
+            }
+            else {
+                return 0;
+            }
+        }
+
+        std::size_t recount_subtree_(node_id_type id) {
+            if (model_.is_leaf_id(id)) {
+                return get_accessor().load_leaf(id).size();
+            }
+            auto inode = get_accessor().load_inode(id);
+            std::size_t total = 0;
+            for (std::size_t i = 0; i <= inode.size(); ++i) {
+                const auto count = recount_subtree_(inode.get_child(i));
+                inode.set_count(i, count);
+                total += count;
+            }
+            return total;
+        }
+
+        //endregion order statistics
+#pragma endregion "order statistics"
+
+        // Separators that cut [lo, hi) into subtrees, in key order. Walks down level by level
+        // and keeps, between the subtrees of one level, the separators of the level above;
+        // stops at the first level that gives `want` parts or right above the leaves.
+        std::vector<key_borrow_type> partition_bounds_(const key_like_type& lo, const key_like_type& hi, std::size_t want) {
+            auto& accessor = get_accessor();
+            std::vector<key_borrow_type> bounds;
+            auto [root, exists] = accessor.load_root();
+            if (!exists) {
+                return bounds;
+            }
+            std::vector<node_id_type> level{ root };
+            while ((bounds.size() + 1 < want) && !model_.is_leaf_id(level.front())) {
+                std::vector<node_id_type> below;
+                std::vector<key_borrow_type> below_bounds;
+                for (std::size_t j = 0; j < level.size(); ++j) {
+                    auto inode = accessor.load_inode(level[j]);
+                    DB_ASSERT(inode.is_valid(), "Something went wrong!");
+                    const auto first = inode.key_position(lo);
+                    const auto last = inode.key_position(hi);
+                    for (std::size_t i = first; i <= last; ++i) {
+                        below.push_back(inode.get_child(i));
+                        if (i < last) {
+                            below_bounds.push_back(inode.borrow_key(i));
+                        }
+                    }
+                    if (j < bounds.size()) {
+                        below_bounds.push_back(std::move(bounds[j]));
+                    }
+                }
+                level = std::move(below);
+                bounds = std::move(below_bounds);
+            }
+            return bounds;
+        }
+
+        // Cursor at the first element not less than `key`. Unlike make_cursor() it leaves
+        // the descent path alone, so parallel scans can seek side by side.
+        cursor_type seek_cursor_(const key_like_type& key) {
+            auto& accessor = get_accessor();
+            auto [current_id, exists] = accessor.load_root();
+            if (!exists) {
+                return {};
+            }
+            while (!model_.is_leaf_id(current_id)) {
+                auto inode = accessor.load_inode(current_id);
+                DB_ASSERT(inode.is_valid(), "Something went wrong!");
+                current_id = inode.get_child(inode.key_position(key));
+            }
+            auto leaf = accessor.load_leaf(current_id);
+            const auto pos = leaf.key_position(key);
+            return cursor_type(model_, std::move(leaf), pos);
+        }
+
         auto get_invalid_id() const noexcept {
             return model_.get_invalid_node_id();
         }
@@ -1314,6 +2928,18 @@ namespace fulla::bpt {
 
         std::size_t find_child_index_in_parent(const inode_type& parent, const node_id_type node) {
             if (parent.is_valid()) {
+                const auto parent_id = parent.self();
+                for (const auto& step : descent_path_) {
+                    if (step.node == parent_id) {
+                        // splits and borrows since the descent can shift the child by one
+                        for (const auto pos : { step.pos, step.pos + 1, step.pos - 1 }) {
+                            if ((pos <= parent.size()) && (parent.get_child(pos) == node)) {
+                                return pos;
+                            }
+                        }
+                        break;
+                    }
+                }
                 for (std::size_t id = 0; id < parent.size() + 1; ++id) {
                     if (parent.get_child(id) == node) {
                         return id;
@@ -1325,11 +2951,13 @@ namespace fulla::bpt {
 
         template <typename NodeT>
         node_id_type find_left_sibling(NodeT& node) {
-            auto parent = get_accessor().load_inode(node.get_parent());
+            auto parent = get_accessor().load_inode(parent_of(node));
             if (parent.is_valid()) {
                 const std::size_t pos = find_child_index_in_parent(parent, node.self());
                 if ((pos != npos) && (pos != 0)) {
-                    return parent.get_child(pos - 1);
+                    const auto sibling = parent.get_child(pos - 1);
+                    remember_parent(sibling, parent.self());
+                    return sibling;
                 }
             }
             return get_invalid_id();
@@ -1337,11 +2965,13 @@ namespace fulla::bpt {
 
         template <typename NodeT>
         node_id_type find_right_sibling(NodeT& node) {
-            auto parent = get_accessor().load_inode(node.get_parent());
+            auto parent = get_accessor().load_inode(parent_of(node));
             if (parent.is_valid()) {
                 const std::size_t pos = find_child_index_in_parent(parent, node.self());
                 if ((pos != npos) && ((pos + 1) <= parent.size())) {
-                    return parent.get_child(pos + 1);
+                    const auto sibling = parent.get_child(pos + 1);
+                    remember_parent(sibling, parent.self());
+                    return sibling;
                 }
             }
             return get_invalid_id();
@@ -1370,6 +3000,114 @@ namespace fulla::bpt {
             }
         }
 
+        // Parent links. Models whose nodes store a parent id (NodeParentLink) keep using it;
+        // for the others the tree keeps the links in parent_ids_, filled by the descent of the
+        // current operation and by its structural changes. Unknown nodes are located by
+        // routing from the root.
+        template <typename NodeT>
+        node_id_type parent_of(NodeT& node) {
+            if constexpr (has_parent_links) {
+                return node.get_parent();
+            }
+            else {
+                const auto self = node.self();
+                auto [root, exists] = get_accessor().load_root();
+                if (!exists || (self == root)) {
+                    return get_invalid_id();
+                }
+                if (auto itr = parent_ids_.find(self); itr != parent_ids_.end()) {
+                    return itr->second;
+                }
+                const auto parent = find_parent_by_route(self, root);
+                parent_ids_[self] = parent;
+                return parent;
+            }
+        }
+
+        template <typename NodeT>
+        void link_parent(NodeT& node, node_id_type parent) {
+            if constexpr (has_parent_links) {
+                node.set_parent(parent);
+            }
+            else {
+                link_parent_id(node.self(), parent);
+            }
+        }
+
+        void link_parent_id(node_id_type child, node_id_type parent) {
+            if constexpr (has_parent_links) {
+                visit_node([&](auto& c) { c.set_parent(parent); }, child);
+            }
+            else if (model_.is_valid_id(parent)) {
+                parent_ids_[child] = parent;
+            }
+            else {
+                parent_ids_.erase(child);
+            }
+        }
+
+        void remember_parent(node_id_type child, node_id_type parent) {
+            if constexpr (!has_parent_links) {
+                parent_ids_[child] = parent;
+            }
+        }
+
+        // Every modifying operation starts here: the descent path and the parent table only
+        // keep what the operation itself learns, so they never outgrow the nodes it touches.
+        // Lookups leave both alone.
+        void start_operation_() {
+            descent_path_.clear();
+            if constexpr (!has_parent_links) {
+                parent_ids_.clear();
+            }
+        }
+
+        // Finds the parent of `node` by descending from the root with the first key
+        // stored under it.
+        node_id_type find_parent_by_route(node_id_type node, node_id_type root) {
+            auto& accessor = get_accessor();
+            auto first = node;
+            while (!model_.is_leaf_id(first)) {
+                first = accessor.load_inode(first).get_child(0);
+            }
+            auto leaf = accessor.load_leaf(first);
+            if (leaf.size() == 0) {
+                DB_ASSERT(false, "can't route to an empty node");
+                return get_invalid_id();
+            }
+            const auto first_key = leaf.get_key(0);
+            const auto key = model_.key_out_as_like(first_key);
+            auto current = root;
+            while (!model_.is_leaf_id(current)) {
+                auto inode = accessor.load_inode(current);
+                const auto child = inode.get_child(inode.key_position(key));
+                if (child == node) {
+                    return current;
+                }
+                current = child;
+            }
+            DB_ASSERT(false, "node is not reachable from the root");
+            return get_invalid_id();
+        }
+
+        // The element at `pos` leaves the tree; see concepts::LeafReleaseValue.
+        static void release_value(leaf_type& leaf, std::size_t pos) {
+            if constexpr (concepts::LeafReleaseValue<leaf_type>) {
+                leaf.release_value(pos);
+            }
+        }
+
+        // Destroys a node that has left the tree and forgets the hints that point to it.
+        void drop_node(node_id_type id) {
+            if (id == append_leaf_) {
+                append_leaf_ = get_invalid_id();
+            }
+            if constexpr (!has_parent_links) {
+                parent_ids_.erase(id);
+            }
+            get_accessor().destroy(id);
+        }
+
         bool is_full(const auto& node) const {
             return node.is_full();
         }
@@ -1382,19 +3120,112 @@ namespace fulla::bpt {
             return parent_node.get_child(parent_node.children_count()) == node.self();
         }
 
+        // ExactMatch: only `found` matters, the position of a missing key is not needed.
+        // ReadOnly: a lookup; the descent starts no operation and records nothing.
+        template <bool ExactMatch = false, bool ReadOnly = false>
         search_result find_node_with(const key_like_type &key) {
             auto [root, exists] = get_accessor().load_root();
             if (exists) {
-                return find_node_with_(key, root);
+                return find_node_with_<ExactMatch, ReadOnly>(key, root);
             }
             return {};
         }
 
+        // Same answer as find_node_with<true>, but leaves the descent path and the parent
+        // cache alone: lookups that run side by side (see locked_tree) only read.
+        // With inode right-links (B-link models) it moves right along the sibling links when
+        // the key sorts past a node, so a node that split after its parent was read is still
+        // searched correctly.
+        search_result locate_(const key_like_type& key) {
+            auto [root, exists] = get_accessor().load_root();
+            if (!exists) {
+                return {};
+            }
+            return locate_(key, root);
+        }
+
+        // Starts from any node left of the key on its level, e.g. one read before a split.
+        search_result locate_(const key_like_type& key, node_id_type current_id) {
+            auto& accessor = get_accessor();
+            while (!model_.is_leaf_id(current_id)) {
+                auto inode = accessor.load_inode(current_id);
+                DB_ASSERT(inode.is_valid(), "Something went wrong!");
+                const auto pos = inode.key_position(key);
+                if constexpr (has_inode_links) {
+                    if ((pos == inode.size()) && belongs_right(inode.get_next(), key, false)) {
+                        current_id = inode.get_next();
+                        continue;
+                    }
+                }
+                current_id = inode.get_child(pos);
+            }
+            while (true) {
+                auto leaf = accessor.load_leaf(current_id);
+                std::size_t pos = 0;
+                bool found = false;
+                if constexpr (concepts::LeafFindKey<leaf_type, key_like_type>) {
+                    pos = leaf.find_key(key);
+                    found = (pos != leaf.size());
+                }
+                else {
+                    pos = leaf.key_position(key);
+                    found = (pos != leaf.size()) && leaf.keys_eq(model_.key_out_as_like(leaf.get_key(pos)), key);
+                }
+                if constexpr (has_inode_links) {
+                    if (!found && (leaf.size() > 0)
+                        && !model_.key_less(key, model_.key_out_as_like(leaf.get_key(leaf.size() - 1)))
+                        && belongs_right(leaf.get_next(), key, true)) {
+                        current_id = leaf.get_next();
+                        continue;
+                    }
+                }
+                return { current_id, pos, found };
+            }
+        }
+
+        // Whether `key` lies in the range of the right-link `next_id` or further right.
+        // The pages keep no high keys; the first key of the neighbour stands in for the
+        // one its parent routes by. For a leaf that is exact, for an inode it is a lower
+        // estimate and the leaf level catches the rest.
+        bool belongs_right(node_id_type next_id, const key_like_type& key, bool leaf_level) {
+            if (!model_.is_valid_id(next_id)) {
+                return false;
+            }
+            auto& accessor = get_accessor();
+            if (leaf_level) {
+                auto next = accessor.load_leaf(next_id);
+                return (next.size() > 0) && !model_.key_less(key, model_.key_out_as_like(next.get_key(0)));
+            }
+            auto next = accessor.load_inode(next_id);
+            return (next.size() > 0) && !model_.key_less(key, model_.key_out_as_like(next.get_key(0)));
+        }
+
+        std::pair<iterator, bool> lower_bound_(const key_like_type& key) {
+            auto [nodeid, pos, found] = find_node_with<false, true>(key);
+            if (!model_.is_valid_id(nodeid)) {
+                return { end(), false };
+            }
+            auto leaf = get_accessor().load_leaf(nodeid);
+            if (pos < leaf.size()) {
+                return { iterator(this, nodeid, pos), found };
+            }
+            // the key is past the last key of the leaf; the answer is the head of the next one
+            return { iterator(this, leaf.get_next(), 0), false };
+        }
+
+        template <bool ExactMatch = false, bool ReadOnly = false>
         search_result find_node_with_(const key_like_type &key, node_id_type current_id) {
             auto& accessor = get_accessor();
+            if constexpr (!ReadOnly) {
+                start_operation_();
+            }
             while (1) {
                 auto leaf = accessor.load_leaf(current_id);
                 if (leaf.is_valid()) {
+                    if constexpr (ExactMatch && concepts::LeafFindKey<leaf_type, key_like_type>) {
+                        const auto pos = leaf.find_key(key);
+                        return { current_id, pos, pos != leaf.size() };
+                    }
                     const auto pos = leaf.key_position(key);
                     const auto leaf_size = leaf.size();
                     const bool found = (pos != leaf_size) && leaf.keys_eq(model_.key_out_as_like(leaf.get_key(pos)), key);
@@ -1404,7 +3235,12 @@ namespace fulla::bpt {
                     auto inode = accessor.load_inode(current_id);
                     if (inode.is_valid()) {
                         auto pos = inode.key_position(key);
+                        const auto parent_id = current_id;
                         current_id = inode.get_child(pos);
+                        if constexpr (!ReadOnly) {
+                            descent_path_.push_back({ parent_id, pos });
+                            remember_parent(current_id, parent_id);
+                        }
                     }
                     else {
                         DB_ASSERT(false, "Something went wrong!");
@@ -1413,6 +3249,25 @@ namespace fulla::bpt {
             }
         }
 
+        // Descends to the leaf for `key`. `fence` and `fence_pos` receive the tightest separator
+        // above the leaf: every key below it belongs to the same leaf. `fence` stays invalid
+        // for the rightmost leaf.
+        node_id_type find_leaf_with_fence_(const key_like_type& key, node_id_type current_id,
+            inode_type& fence, std::size_t& fence_pos) {
+            auto& accessor = get_accessor();
+            while (!model_.is_leaf_id(current_id)) {
+                auto inode = accessor.load_inode(current_id);
+                DB_ASSERT(inode.is_valid(), "Something went wrong!");
+                const auto pos = inode.key_position(key);
+                current_id = inode.get_child(pos);
+                if (pos < inode.size()) {
+                    fence = std::move(inode);
+                    fence_pos = pos;
+                }
+            }
+            return current_id;
+        }
+
 #if 0
         auto inode_try_to_give(inode_type& node, policies::rebalance rp) {
             return (give_to_right(node, 1, rp) || give_to_left(node, 1, rp));
@@ -1431,20 +3286,20 @@ namespace fulla::bpt {
                         const auto npsize = parent.size();
                         key = model_.key_out_as_like(from_node.get_key(0));
 
-                        const auto pparent = (parent.self() == from_node.get_parent());
-                        const auto rparent = (right.self() == from_node.get_parent());
+                        const auto pparent = (parent.self() == parent_of(from_node));
+                        const auto rparent = (right.self() == parent_of(from_node));
 
-                        auto nparent = get_accessor().load_inode(from_node.get_parent());
+                        auto nparent = get_accessor().load_inode(parent_of(from_node));
                         auto nid = find_child_index_in_parent(nparent, from_node.self());
 
                         if (pos < parent.size()) {
-                            DB_ASSERT(parent.self() == from_node.get_parent(), "parent is not the parent!");
+                            DB_ASSERT(parent.self() == parent_of(from_node), "parent is not the parent!");
                             parent.update_key(pos, key);
                         }
                         else if (pos > parent.size()) {
                             const auto new_pos = pos - parent.size() - 1;
                             DB_ASSERT(new_pos < right.size(), "position is invalid");
-                            DB_ASSERT(right.self() == from_node.get_parent(), "right is not the parent!");
+                            DB_ASSERT(right.self() == parent_of(from_node), "right is not the parent!");
                             right.update_key(new_pos, key);
                         }
                     }
@@ -1478,7 +3333,7 @@ namespace fulla::bpt {
                             node.update_key(pos, key);
                         }
                         else if (node.size() == pos) {
-                            const auto parent = get_accessor().load_inode(node.get_parent());
+                            const auto parent = get_accessor().load_inode(parent_of(node));
                             const auto id = find_child_index_in_parent(parent, node.self());
                             update_inode_key(parent, id, key);
                         }
@@ -1499,20 +3354,22 @@ namespace fulla::bpt {
 #endif 
 
         void update_parent_inode_key(inode_type parent, std::size_t pos, leaf_type from_node) {
-            auto key = model_.key_out_as_like(from_node.get_key(0));
+            auto first_key = from_node.get_key(0);
+            auto key = model_.key_out_as_like(first_key);
             if (!parent.can_update_key(pos, key)) {
                 auto right = handle_inode_overflow(parent, rp_);
                 if (right.is_valid()) {
-                    key = model_.key_out_as_like(from_node.get_key(0));
+                    first_key = from_node.get_key(0);
+                    key = model_.key_out_as_like(first_key);
 
                     if (pos < parent.size()) {
-                        DB_ASSERT(parent.self() == from_node.get_parent(), "parent is not the parent!");
+                        DB_ASSERT(parent.self() == parent_of(from_node), "parent is not the parent!");
                         parent.update_key(pos, key);
                     }
                     else if (pos > parent.size()) {
                         const auto new_pos = pos - parent.size() - 1;
                         DB_ASSERT(new_pos < right.size(), "position is invalid");
-                        DB_ASSERT(right.self() == from_node.get_parent(), "right is not the parent!");
+                        DB_ASSERT(right.self() == parent_of(from_node), "right is not the parent!");
                         right.update_key(new_pos, key);
                     }
                 }
@@ -1531,7 +3388,7 @@ namespace fulla::bpt {
                         node.update_key(pos, key);
                     }
                     else if (node.size() == pos) {
-                        const auto parent = get_accessor().load_inode(node.get_parent());
+                        const auto parent = get_accessor().load_inode(parent_of(node));
                         const auto id = find_child_index_in_parent(parent, node.self());
                         update_inode_key(parent, id, key);
                     }
@@ -1548,7 +3405,7 @@ namespace fulla::bpt {
         }
 
         void fix_parent_index(leaf_type& node) {
-            auto parent = get_accessor().load_inode(node.get_parent());
+            auto parent = get_accessor().load_inode(parent_of(node));
             const auto pos = find_child_index_in_parent(parent, node.self());
             if (pos != npos && pos > 0) {
                 // TODO: check for overflow here
@@ -1574,6 +3431,19 @@ namespace fulla::bpt {
 
         model_type model_;
         policies::rebalance rp_ = policies::rebalance::neighbor_share;
+        bool append_mode_ = false;
+        // the rightmost leaf as of the last append; checked before every use
+        node_id_type append_leaf_ = model_type::get_invalid_node_id();
+        // inodes visited by the last find_node_with_ and the child taken in each;
+        // find_child_index_in_parent uses it as a hint
+        std::vector<path_step> descent_path_;
+        // inodes whose child counts wait for settle_counts_()
+        std::vector<node_id_type> counts_dirty_;
+
+        struct no_parent_table {};
+        using parent_table = std::conditional_t<has_parent_links,
+            no_parent_table, std::unordered_map<node_id_type, node_id_type>>;
+        [[no_unique_address]] parent_table parent_ids_;
     };
 
 } // namespace fulla::bpt
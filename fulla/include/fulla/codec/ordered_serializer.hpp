@@ -0,0 +1,231 @@
+/*
+ * File: ordered_serializer.hpp
+ * Author: newenclave
+ * GitHub: https://github.com/newenclave
+ * Created: 2025-11-16
+ * License: MIT
+ */
+
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "fulla/core/bytes.hpp"
+#include "fulla/core/byteorder.hpp"
+#include "fulla/codec/prop_types.hpp"
+#include "fulla/codec/serializer.hpp"
+#include "fulla/codec/data_view.hpp"
+
+namespace fulla::codec {
+
+    using core::byte;
+    using core::byte_buffer;
+    using core::byte_span;
+    using core::byte_view;
+
+	// Order-preserving (normalized) key encoding. Two encoded keys compare with a plain
+	// memcmp exactly as data_view::compare orders the typed values they were built from,
+	// so trees over them can use page::bytewise_less instead of decoding on every compare.
+	//
+	// Every value starts with its data_type as one byte (values of different types order
+	// by type id, as in data_view::compare), followed by:
+	//   - integers: big-endian, the sign bit flipped for signed types;
+	//   - floats: big-endian IEEE bits, all bits inverted for negatives and only the sign
+	//     bit flipped otherwise. -0.0 is stored as 0.0, NaNs as one NaN above +inf;
+	//   - strings and blobs: the bytes with 0x00 escaped as 0x00 0xFF, closed by 0x00 0x01;
+	//   - tuples: the encoded elements closed by 0x00 (lower than any type byte, so a
+	//     tuple sorts before every longer tuple it is a prefix of).
+	// The encoding is one-way: it is meant for keys, the values live elsewhere.
+	class ordered_serializer {
+	public:
+
+		constexpr static byte escape_byte = byte{ 0x00 };
+		constexpr static byte escaped_zero = byte{ 0xFF };
+		constexpr static byte bytes_end = byte{ 0x01 };
+		constexpr static byte tuple_end = byte{ 0x00 };
+
+		template <typename T>
+		ordered_serializer& store(const T& val) {
+			if constexpr (std::is_same_v<T, std::string>) {
+				return store_blob(reinterpret_cast<const byte*>(val.data()), val.size(), data_type::string);
+			}
+			else if constexpr (std::is_same_v<T, std::uint32_t>) {
+				put_type(data_type::ui32);
+				put_word(val);
+			}
+			else if constexpr (std::is_same_v<T, std::uint64_t>) {
+				put_type(data_type::ui64);
+				put_word(val);
+			}
+			else if constexpr (std::is_same_v<T, std::int32_t>) {
+				put_type(data_type::i32);
+				put_word(flip_sign(val));
+			}
+			else if constexpr (std::is_same_v<T, std::int64_t>) {
+				put_type(data_type::i64);
+				put_word(flip_sign(val));
+			}
+			else if constexpr (std::is_same_v<T, float>) {
+				put_type(data_type::fp32);
+				put_word(float_bits<std::uint32_t>(val));
+			}
+			else if constexpr (std::is_same_v<T, double>) {
+				put_type(data_type::fp64);
+				put_word(float_bits<std::uint64_t>(val));
+			}
+			else {
+				static_assert(sizeof(T) == 0, "ordered_serializer: unsupported type");
+			}
+			return *this;
+		}
+
+		// `t` is data_type::string or data_type::blob.
+		ordered_serializer& store_blob(const byte* data, std::size_t len, data_type t = data_type::blob) {
+			put_type(t);
+			buffer_.reserve(buffer_.size() + len + 2);
+			for (std::size_t i = 0; i < len; ++i) {
+				buffer_.push_back(data[i]);
+				if (data[i] == escape_byte) {
+					buffer_.push_back(escaped_zero);
+				}
+			}
+			buffer_.push_back(escape_byte);
+			buffer_.push_back(bytes_end);
+			return *this;
+		}
+
+		ordered_serializer& begin_tuple() {
+			put_type(data_type::tuple);
+			return *this;
+		}
+
+		ordered_serializer& end_tuple() {
+			buffer_.push_back(tuple_end);
+			return *this;
+		}
+
+		// Re-encodes a record produced by data_serializer (one or more values, tuples included).
+		// Returns false on a malformed record; the buffer is left partially written then.
+		bool append_record(byte_view record) {
+			while (!record.empty()) {
+				const auto t = data_view::get_type(record);
+				const auto full_size = (t == data_type::undefined) ? 0 : data_view::get_size(record);
+				if (full_size <= sizeof(serialized_data_header) || full_size > record.size()) {
+					return false;
+				}
+				const auto payload = record.subspan(sizeof(serialized_data_header), full_size - sizeof(serialized_data_header));
+				if (!append_value(t, payload)) {
+					return false;
+				}
+				record = record.subspan(full_size);
+			}
+			return true;
+		}
+
+		std::size_t size() const {
+			return buffer_.size();
+		}
+
+		const byte* data() const { return buffer_.data(); }
+
+		byte_span span() {
+			return byte_span(buffer_.data(), buffer_.size());
+		}
+
+		byte_view view() const {
+			return byte_view(buffer_.data(), buffer_.size());
+		}
+
+	private:
+
+		bool append_value(data_type t, byte_view payload) {
+			switch (t) {
+			case data_type::i32:
+				return append_word<std::int32_t>(payload);
+			case data_type::i64:
+				return append_word<std::int64_t>(payload);
+			case data_type::ui32:
+				return append_word<std::uint32_t>(payload);
+			case data_type::ui64:
+				return append_word<std::uint64_t>(payload);
+			case data_type::fp32:
+				return append_word<float>(payload);
+			case data_type::fp64:
+				return append_word<double>(payload);
+			case data_type::string:
+			case data_type::blob:
+			case data_type::tuple: {
+				const auto [total, len_size] = serializer<std::uint32_t>::load(payload.data(), payload.size());
+				// strings carry a null-terminator that is not a part of the value
+				const std::size_t tail = (t == data_type::string) ? 1 : 0;
+				if (total < len_size + tail || total > payload.size()) {
+					return false;
+				}
+				const auto body = payload.subspan(len_size, total - len_size - tail);
+				if (t != data_type::tuple) {
+					store_blob(body.data(), body.size(), t);
+					return true;
+				}
+				begin_tuple();
+				if (!append_record(body)) {
+					return false;
+				}
+				end_tuple();
+				return true;
+			}
+			default:
+				break;
+			}
+			return false;
+		}
+
+		template <typename T>
+		bool append_word(byte_view payload) {
+			if (payload.size() < sizeof(T)) {
+				return false;
+			}
+			auto [val, _] = serializer<T>::load(payload.data(), payload.size());
+			store<T>(val);
+			return true;
+		}
+
+		void put_type(data_type t) {
+			buffer_.push_back(static_cast<byte>(t));
+		}
+
+		template <core::byteorder::UnsignedWord WordT>
+		void put_word(WordT val) {
+			const auto old_size = buffer_.size();
+			buffer_.resize(old_size + sizeof(WordT));
+			core::byteorder::native_to_be<WordT>(val, buffer_.data() + old_size);
+		}
+
+		template <typename SignedT>
+		static auto flip_sign(SignedT val) {
+			using unsigned_type = std::make_unsigned_t<SignedT>;
+			constexpr auto sign_bit = unsigned_type{ 1 } << (sizeof(unsigned_type) * 8 - 1);
+			return static_cast<unsigned_type>(static_cast<unsigned_type>(val) ^ sign_bit);
+		}
+
+		template <typename UnsignedT, typename FloatT>
+		static UnsignedT float_bits(FloatT val) {
+			static_assert(sizeof(UnsignedT) == sizeof(FloatT));
+			constexpr auto sign_bit = UnsignedT{ 1 } << (sizeof(UnsignedT) * 8 - 1);
+			if (std::isnan(val)) {
+				val = std::numeric_limits<FloatT>::quiet_NaN();
+			}
+			else if (val == FloatT{ 0 }) {
+				val = FloatT{ 0 }; // -0.0 == 0.0
+			}
+			const auto bits = std::bit_cast<UnsignedT>(val);
+			return (bits & sign_bit) ? static_cast<UnsignedT>(~bits) : static_cast<UnsignedT>(bits | sign_bit);
+		}
+
+		byte_buffer buffer_;
+	};
+
+} // namespace fulla::codec
@@ -17,6 +17,7 @@
 #include "fulla/codec/serializer.hpp"
 #include "fulla/codec/prop_types.hpp"
 #include "fulla/codec/data_serializer.hpp"
+#include "fulla/codec/ordered_serializer.hpp"
 
 namespace fulla::codec::prop {
 
@@ -89,4 +90,28 @@ namespace fulla::codec::prop {
         return r;
     }
 
+    // ----- Order-preserving keys: the same values, encoded for memcmp (see ordered_serializer) -----
+    inline void append_ordered(ordered_serializer& os, const ui32& x) { os.store<std::uint32_t>(x.v); }
+    inline void append_ordered(ordered_serializer& os, const ui64& x) { os.store<std::uint64_t>(x.v); }
+    inline void append_ordered(ordered_serializer& os, const i32&  x) { os.store<std::int32_t>(x.v); }
+    inline void append_ordered(ordered_serializer& os, const i64&  x) { os.store<std::int64_t>(x.v); }
+    inline void append_ordered(ordered_serializer& os, const fp32& x) { os.store<float>(x.v); }
+    inline void append_ordered(ordered_serializer& os, const fp64& x) { os.store<double>(x.v); }
+    inline void append_ordered(ordered_serializer& os, const str&  x) { os.store<std::string>(x.v); }
+    inline void append_ordered(ordered_serializer& os, const blob& x) { os.store_blob(x.v.data(), x.v.size(), data_type::blob); }
+    inline void append_ordered(ordered_serializer& os, const tuple& t) { os.append_record(t.view()); }
+
+    // Build a key that compares with page::bytewise_less as data_view::compare_sequence
+    // orders the record make_record(xs...) would build.
+    template <typename... Ts>
+    rec make_ordered_record(Ts&&... xs) {
+        ordered_serializer os;
+        (append_ordered(os, std::forward<Ts>(xs)), ...);
+
+        rec r;
+        r.buf.resize(os.size());
+        std::memcpy(r.buf.data(), os.data(), os.size());
+        return r;
+    }
+
 } // namespace fulla::codec::prop
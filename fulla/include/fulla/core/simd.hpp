@@ -0,0 +1,304 @@
+/*
+ * File: simd.hpp
+ * Author: newenclave
+ * GitHub: https://github.com/newenclave
+ * Created: 2025-11-16
+ * License: MIT
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <concepts>
+#include <limits>
+
+#include "fulla/core/bytes.hpp"
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#   define FULLA_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define FULLA_SIMD_SSE2 1
+#   if defined(__SSE4_2__)
+#       include <nmmintrin.h>
+#       define FULLA_SIMD_SSE42 1
+#   endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#   include <arm_neon.h>
+#   define FULLA_SIMD_NEON 1
+#endif
+
+// Searches over sorted arrays of 32/64-bit integers stored back to back (in host order,
+// not necessarily aligned). A short binary search narrows the range down to a few
+// vectors, the rest is counted with vector compares: in a sorted array the number of
+// words below the key is its lower bound. find_byte scans byte arrays for a value.
+namespace fulla::core::simd {
+
+    template <typename T>
+    concept SearchWord = std::same_as<T, std::uint32_t> || std::same_as<T, std::int32_t>
+        || std::same_as<T, std::uint64_t> || std::same_as<T, std::int64_t>;
+
+    template <SearchWord T>
+    inline T load_word(const byte* where) noexcept {
+        T val;
+        std::memcpy(&val, where, sizeof(T));
+        return val;
+    }
+
+    namespace detail {
+
+        // signed compares only; unsigned words are biased into the signed range first
+        template <SearchWord T>
+        constexpr auto sign_bias() noexcept {
+            using unsigned_type = std::make_unsigned_t<T>;
+            return std::is_signed_v<T> ? unsigned_type{ 0 } : unsigned_type{ 1 } << (sizeof(T) * 8 - 1);
+        }
+
+#if defined(FULLA_SIMD_AVX2)
+        constexpr std::size_t vector_bytes = 32;
+
+        template <SearchWord T>
+        inline __m256i broadcast(T val) noexcept {
+            if constexpr (sizeof(T) == 4) {
+                return _mm256_set1_epi32(static_cast<std::int32_t>(static_cast<std::uint32_t>(val) ^ sign_bias<T>()));
+            }
+            else {
+                return _mm256_set1_epi64x(static_cast<std::int64_t>(static_cast<std::uint64_t>(val) ^ sign_bias<T>()));
+            }
+        }
+
+        template <SearchWord T>
+        inline __m256i load_biased(const byte* where) noexcept {
+            return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(where)), broadcast<T>(T{ 0 }));
+        }
+
+        template <SearchWord T>
+        inline unsigned gt_mask(__m256i a, __m256i b) noexcept {
+            if constexpr (sizeof(T) == 4) {
+                return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b))));
+            }
+            else {
+                return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a, b))));
+            }
+        }
+
+        template <bool OrEqual, SearchWord T>
+        inline std::size_t count_vector(const byte* data, T key) noexcept {
+            constexpr unsigned lanes = vector_bytes / sizeof(T);
+            const auto k = broadcast<T>(key);
+            const auto v = load_biased<T>(data);
+            // below: k > v; not greater: !(v > k)
+            return static_cast<std::size_t>(OrEqual ? lanes - static_cast<unsigned>(std::popcount(gt_mask<T>(v, k)))
+                : static_cast<unsigned>(std::popcount(gt_mask<T>(k, v))));
+        }
+
+        template <SearchWord T>
+        constexpr bool has_vector() noexcept { return true; }
+
+        constexpr std::size_t byte_lanes = 32;
+        constexpr unsigned mask_bits_per_byte = 1;
+
+        inline std::uint64_t equal_bytes_mask(const byte* data, std::uint8_t value) noexcept {
+            const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            const auto eq = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(value)));
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+        }
+
+#elif defined(FULLA_SIMD_SSE2)
+        constexpr std::size_t vector_bytes = 16;
+
+        template <SearchWord T>
+        constexpr bool has_vector() noexcept { return true; }
+
+        template <SearchWord T>
+        inline __m128i broadcast(T val) noexcept {
+            if constexpr (sizeof(T) == 4) {
+                return _mm_set1_epi32(static_cast<std::int32_t>(static_cast<std::uint32_t>(val) ^ sign_bias<T>()));
+            }
+            else {
+                return _mm_set1_epi64x(static_cast<std::int64_t>(static_cast<std::uint64_t>(val) ^ sign_bias<T>()));
+            }
+        }
+
+        template <SearchWord T>
+        inline __m128i load_biased(const byte* where) noexcept {
+            return _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(where)), broadcast<T>(T{ 0 }));
+        }
+
+        template <SearchWord T>
+        inline unsigned gt_mask(__m128i a, __m128i b) noexcept {
+            if constexpr (sizeof(T) == 4) {
+                return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a, b))));
+            }
+            else {
+#   if defined(FULLA_SIMD_SSE42)
+                return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(a, b))));
+#   else
+                // 64-bit compares came with SSE4.2: the high halves decide as signed words,
+                // equal high halves leave it to the low ones compared as unsigned. The
+                // result ends up in the high half of each lane, where movemask_pd reads it.
+                const auto low_bias = _mm_set_epi32(0, std::numeric_limits<std::int32_t>::min(),
+                    0, std::numeric_limits<std::int32_t>::min());
+                const auto high_gt = _mm_cmpgt_epi32(a, b);
+                const auto high_eq = _mm_cmpeq_epi32(a, b);
+                const auto low_gt = _mm_cmpgt_epi32(_mm_xor_si128(a, low_bias), _mm_xor_si128(b, low_bias));
+                const auto gt = _mm_or_si128(high_gt,
+                    _mm_and_si128(high_eq, _mm_shuffle_epi32(low_gt, _MM_SHUFFLE(2, 2, 0, 0))));
+                return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(gt)));
+#   endif
+            }
+        }
+
+        template <bool OrEqual, SearchWord T>
+        inline std::size_t count_vector(const byte* data, T key) noexcept {
+            constexpr unsigned lanes = vector_bytes / sizeof(T);
+            const auto k = broadcast<T>(key);
+            const auto v = load_biased<T>(data);
+            // below: k > v; not greater: !(v > k)
+            return static_cast<std::size_t>(OrEqual ? lanes - static_cast<unsigned>(std::popcount(gt_mask<T>(v, k)))
+                : static_cast<unsigned>(std::popcount(gt_mask<T>(k, v))));
+        }
+
+        constexpr std::size_t byte_lanes = 16;
+        constexpr unsigned mask_bits_per_byte = 1;
+
+        inline std::uint64_t equal_bytes_mask(const byte* data, std::uint8_t value) noexcept {
+            const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            const auto eq = _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(value)));
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(eq));
+        }
+
+#elif defined(FULLA_SIMD_NEON)
+        constexpr std::size_t vector_bytes = 16;
+
+        template <SearchWord T>
+        constexpr bool has_vector() noexcept { return true; }
+
+        template <bool OrEqual, SearchWord T>
+        inline std::size_t count_vector(const byte* data, T key) noexcept {
+            // every matching lane is all ones: shift down to one bit and add the lanes up
+            if constexpr (std::same_as<T, std::uint32_t>) {
+                const auto v = vld1q_u32(reinterpret_cast<const std::uint32_t*>(data));
+                const auto k = vdupq_n_u32(key);
+                return vaddvq_u32(vshrq_n_u32(OrEqual ? vcleq_u32(v, k) : vcltq_u32(v, k), 31));
+            }
+            else if constexpr (std::same_as<T, std::int32_t>) {
+                const auto v = vld1q_s32(reinterpret_cast<const std::int32_t*>(data));
+                const auto k = vdupq_n_s32(key);
+                return vaddvq_u32(vshrq_n_u32(OrEqual ? vcleq_s32(v, k) : vcltq_s32(v, k), 31));
+            }
+            else if constexpr (std::same_as<T, std::uint64_t>) {
+                const auto v = vld1q_u64(reinterpret_cast<const std::uint64_t*>(data));
+                const auto k = vdupq_n_u64(key);
+                return static_cast<std::size_t>(vaddvq_u64(vshrq_n_u64(OrEqual ? vcleq_u64(v, k) : vcltq_u64(v, k), 63)));
+            }
+            else {
+                const auto v = vld1q_s64(reinterpret_cast<const std::int64_t*>(data));
+                const auto k = vdupq_n_s64(key);
+                return static_cast<std::size_t>(vaddvq_u64(vshrq_n_u64(OrEqual ? vcleq_s64(v, k) : vcltq_s64(v, k), 63)));
+            }
+        }
+
+        constexpr std::size_t byte_lanes = 16;
+        constexpr unsigned mask_bits_per_byte = 4;
+
+        // no movemask: narrowing the compare result leaves 4 bits per byte
+        inline std::uint64_t equal_bytes_mask(const byte* data, std::uint8_t value) noexcept {
+            const auto eq = vceqq_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(data)), vdupq_n_u8(value));
+            return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        }
+
+#else
+        constexpr std::size_t vector_bytes = 16;
+
+        template <SearchWord T>
+        constexpr bool has_vector() noexcept { return false; }
+
+        template <bool OrEqual, SearchWord T>
+        inline std::size_t count_vector(const byte*, T) noexcept { return 0; }
+
+        constexpr std::size_t byte_lanes = 0;
+        constexpr unsigned mask_bits_per_byte = 1;
+
+        inline std::uint64_t equal_bytes_mask(const byte*, std::uint8_t) noexcept { return 0; }
+#endif
+    }
+
+    // Calls `f(i)` for every i < count with data[i] == value, in order, until `f` returns true.
+    // Returns whether it did.
+    template <typename F>
+    inline bool find_byte(const byte* data, std::size_t count, std::uint8_t value, F&& f) {
+        std::size_t i = 0;
+        if constexpr (detail::byte_lanes > 0) {
+            constexpr std::uint64_t lane_mask = (std::uint64_t{ 1 } << detail::mask_bits_per_byte) - 1;
+            for (; i + detail::byte_lanes <= count; i += detail::byte_lanes) {
+                auto mask = detail::equal_bytes_mask(data + i, value);
+                while (mask != 0) {
+                    const auto lane = static_cast<std::size_t>(std::countr_zero(mask)) / detail::mask_bits_per_byte;
+                    if (f(i + lane)) {
+                        return true;
+                    }
+                    mask &= ~(lane_mask << (lane * detail::mask_bits_per_byte));
+                }
+            }
+        }
+        for (; i < count; ++i) {
+            if (static_cast<std::uint8_t>(data[i]) == value && f(i)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Number of the first `count` words at `data` that are less than (OrEqual: not greater than) `key`.
+    template <bool OrEqual, SearchWord T>
+    inline std::size_t count_below(const byte* data, std::size_t count, T key) noexcept {
+        constexpr std::size_t lanes = detail::vector_bytes / sizeof(T);
+        std::size_t i = 0;
+        std::size_t result = 0;
+        if constexpr (detail::has_vector<T>()) {
+            for (; i + lanes <= count; i += lanes) {
+                result += detail::count_vector<OrEqual, T>(data + i * sizeof(T), key);
+            }
+        }
+        for (; i < count; ++i) {
+            const auto val = load_word<T>(data + i * sizeof(T));
+            result += OrEqual ? (val <= key) : (val < key);
+        }
+        return result;
+    }
+
+    // std::lower_bound (UpperBound = false) or std::upper_bound over `count` sorted words.
+    template <bool UpperBound, SearchWord T>
+    inline std::size_t bound(const byte* data, std::size_t count, T key) noexcept {
+        constexpr std::size_t linear_tail = 2 * detail::vector_bytes / sizeof(T);
+        std::size_t lo = 0;
+        std::size_t len = count;
+        while (len > linear_tail) {
+            const auto half = len / 2;
+            const auto val = load_word<T>(data + (lo + half) * sizeof(T));
+            if (UpperBound ? !(key < val) : (val < key)) {
+                lo += half + 1;
+                len -= half + 1;
+            }
+            else {
+                len = half;
+            }
+        }
+        return lo + count_below<UpperBound, T>(data + lo * sizeof(T), len, key);
+    }
+
+    template <SearchWord T>
+    inline std::size_t lower_bound(const byte* data, std::size_t count, T key) noexcept {
+        return bound<false, T>(data, count, key);
+    }
+
+    template <SearchWord T>
+    inline std::size_t upper_bound(const byte* data, std::size_t count, T key) noexcept {
+        return bound<true, T>(data, count, key);
+    }
+
+} // namespace fulla::core::simd
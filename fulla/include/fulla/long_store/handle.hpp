@@ -620,14 +620,15 @@ namespace fulla::long_store {
 				handle_base* page_ptr = nullptr;
 				std::size_t available = 0;
 
+				// page_ptr refers into pv, which outlives the write below
 				if (std::holds_alternative<header_handle>(pv)) {
-					auto h = std::get<header_handle>(pv);
+					auto& h = std::get<header_handle>(pv);
 					dst = h.rw_all_data().data() + offset_in_page;
 					available = (h.capacity() - offset_in_page);
 					page_ptr = &h;
 				}
 				else if (std::holds_alternative<chunk_handle>(pv)) {
-					auto c = std::get<chunk_handle>(pv);
+					auto& c = std::get<chunk_handle>(pv);
 					dst = c.rw_all_data().data() + offset_in_page;
 					available = (c.capacity() - offset_in_page);
 					page_ptr = &c;
@@ -0,0 +1,59 @@
+/*
+ * File: bpt_fixed.hpp
+ * Author: newenclave
+ * GitHub: https://github.com/newenclave
+ * Created: 2025-11-16
+ * License: MIT
+ */
+
+#pragma once
+
+#include "fulla/core/pack.hpp"
+#include "fulla/core/types.hpp"
+
+namespace fulla::page {
+
+    using core::word_u16;
+    using core::word_u32;
+
+    // Pages of B+ trees with fixed-size keys. No slot directory: the body holds the keys
+    // back to back, followed by an array of the same capacity with the values (leaf)
+    // or the child pids (inode).
+
+FULLA_PACKED_STRUCT_BEGIN
+
+    struct bpt_fixed_leaf_header {
+        word_u32 parent{ 0 };
+        word_u32 prev{ 0 };
+        word_u32 next{ 0 };
+        word_u16 size{ 0 };
+        word_u16 reserved{ 0 };
+
+        void init() {
+            parent = 0;
+            prev = 0;
+            next = 0;
+            size = 0;
+        }
+    } FULLA_PACKED;
+
+    struct bpt_fixed_inode_header {
+        word_u32 parent{ 0 };
+        word_u32 rightmost_child{ 0 };
+        word_u16 size{ 0 };
+        word_u16 reserved{ 0 };
+        word_u32 next{ 0 };
+
+        void init() {
+            parent = 0;
+            rightmost_child = 0;
+            size = 0;
+            next = 0;
+        }
+    } FULLA_PACKED;
+
+FULLA_PACKED_STRUCT_END
+
+    static_assert(sizeof(bpt_fixed_leaf_header) == 16);
+    static_assert(sizeof(bpt_fixed_inode_header) == 16);
+}
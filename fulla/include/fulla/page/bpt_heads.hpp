@@ -0,0 +1,258 @@
+/*
+ * File: bpt_heads.hpp
+ * Author: newenclave
+ * GitHub: https://github.com/newenclave
+ * Created: 2025-11-17
+ * License: MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "fulla/core/bytes.hpp"
+#include "fulla/core/pack.hpp"
+#include "fulla/core/simd.hpp"
+#include "fulla/core/types.hpp"
+
+namespace fulla::page {
+
+    using core::word_u16;
+
+FULLA_PACKED_STRUCT_BEGIN
+
+    // Optional search index placed right after a B+ tree node subheader (the page subheader
+    // grows by its size). heads[i] is the first 4 bytes of key i past the prefix shared by
+    // the page, as a host order word whose order is the order of the bytes; blocks[b] is the
+    // largest head of the b-th run of block_len heads. A search counts one line of block
+    // maxima and one line of heads instead of reading the slot bodies.
+    struct bpt_key_heads {
+        constexpr static const std::size_t block_len = 16;
+        constexpr static const std::size_t head_size = sizeof(std::uint32_t);
+        constexpr static const std::uint16_t tag_value = 0x4448; // "HD"
+
+        word_u16 tag{ 0 };
+        word_u16 capacity{ 0 };
+        word_u16 count{ 0 };    // 0 when the page holds more keys than the index fits
+        word_u16 prefix_len{ 0 };
+
+        constexpr static std::size_t bytes_for(std::size_t heads) noexcept {
+            return sizeof(bpt_key_heads) + (heads + heads / block_len) * head_size;
+        }
+
+        static std::uint32_t make_head(core::byte_view suffix) noexcept {
+            std::uint32_t head = 0;
+            for (std::size_t i = 0; i < head_size; ++i) {
+                const auto b = (i < suffix.size()) ? static_cast<std::uint8_t>(suffix[i]) : std::uint8_t{ 0 };
+                head = (head << 8) | b;
+            }
+            return head;
+        }
+
+        void init(std::size_t heads) {
+            tag = tag_value;
+            capacity = static_cast<word_u16::word_type>(heads - heads % block_len);
+            count = 0;
+            prefix_len = 0;
+        }
+
+        std::size_t block_size() const noexcept {
+            return bytes_for(capacity.get());
+        }
+
+        core::byte* blocks() noexcept {
+            return reinterpret_cast<core::byte*>(this) + sizeof(bpt_key_heads);
+        }
+
+        const core::byte* blocks() const noexcept {
+            return reinterpret_cast<const core::byte*>(this) + sizeof(bpt_key_heads);
+        }
+
+        core::byte* heads() noexcept {
+            return blocks() + capacity.get() / block_len * head_size;
+        }
+
+        const core::byte* heads() const noexcept {
+            return blocks() + capacity.get() / block_len * head_size;
+        }
+
+        void set_head(std::size_t pos, std::uint32_t head) noexcept {
+            std::memcpy(heads() + pos * head_size, &head, head_size);
+        }
+
+        // Shifts the heads at and after `pos` one step right; the caller seals.
+        bool insert_head(std::size_t pos, std::uint32_t head) noexcept {
+            const std::size_t total = count.get();
+            if (total >= capacity.get() || pos > total) {
+                return false;
+            }
+            std::memmove(heads() + (pos + 1) * head_size, heads() + pos * head_size, (total - pos) * head_size);
+            set_head(pos, head);
+            return true;
+        }
+
+        bool erase_head(std::size_t pos) noexcept {
+            const std::size_t total = count.get();
+            if (pos >= total) {
+                return false;
+            }
+            std::memmove(heads() + pos * head_size, heads() + (pos + 1) * head_size, (total - pos - 1) * head_size);
+            return true;
+        }
+
+        // Sets the count and refreshes the block maxima from the block holding `from` on.
+        void seal(std::size_t total, std::size_t from = 0) noexcept {
+            for (std::size_t b = from / block_len; b * block_len < total; ++b) {
+                const auto last = std::min((b + 1) * block_len, total) - 1;
+                std::memcpy(blocks() + b * head_size, heads() + last * head_size, head_size);
+            }
+            count = static_cast<word_u16::word_type>(total);
+        }
+
+        // Number of heads less than (OrEqual: not greater than) `head`.
+        template <bool OrEqual>
+        std::size_t count_below(std::uint32_t head) const noexcept {
+            const std::size_t total = count.get();
+            const std::size_t block_count = (total + block_len - 1) / block_len;
+            const auto block = core::simd::count_below<OrEqual, std::uint32_t>(blocks(), block_count, head);
+            if (block == block_count) {
+                return total;
+            }
+            const auto first = block * block_len;
+            return first + core::simd::count_below<OrEqual, std::uint32_t>(
+                heads() + first * head_size, std::min(block_len, total - first), head);
+        }
+    } FULLA_PACKED;
+
+    // Optional leaf block that follows bpt_key_heads (or takes its place): a one byte hash
+    // of every key in slot order. An exact match lookup scans it and compares the full key
+    // only where the byte matches.
+    struct bpt_key_fingerprints {
+        constexpr static const std::size_t block_len = 16;
+        constexpr static const std::uint16_t tag_value = 0x5046; // "FP"
+
+        word_u16 tag{ 0 };
+        word_u16 capacity{ 0 };
+        word_u16 count{ 0 };    // 0 when the page holds more keys than the block fits
+        word_u16 reserved{ 0 };
+
+        constexpr static std::size_t bytes_for(std::size_t prints) noexcept {
+            return sizeof(bpt_key_fingerprints) + prints;
+        }
+
+        // FNV-1a folded down to one byte
+        static std::uint8_t make_fingerprint(core::byte_view key) noexcept {
+            std::uint32_t hash = 2166136261u;
+            for (auto b : key) {
+                hash = (hash ^ static_cast<std::uint8_t>(b)) * 16777619u;
+            }
+            hash ^= hash >> 16;
+            hash ^= hash >> 8;
+            return static_cast<std::uint8_t>(hash);
+        }
+
+        void init(std::size_t prints) {
+            tag = tag_value;
+            capacity = static_cast<word_u16::word_type>(prints - prints % block_len);
+            count = 0;
+        }
+
+        std::size_t block_size() const noexcept {
+            return bytes_for(capacity.get());
+        }
+
+        core::byte* prints() noexcept {
+            return reinterpret_cast<core::byte*>(this) + sizeof(bpt_key_fingerprints);
+        }
+
+        const core::byte* prints() const noexcept {
+            return reinterpret_cast<const core::byte*>(this) + sizeof(bpt_key_fingerprints);
+        }
+
+        void set_print(std::size_t pos, std::uint8_t fp) noexcept {
+            prints()[pos] = static_cast<core::byte>(fp);
+        }
+
+        bool insert_print(std::size_t pos, std::uint8_t fp) noexcept {
+            const std::size_t total = count.get();
+            if (total >= capacity.get() || pos > total) {
+                return false;
+            }
+            std::memmove(prints() + pos + 1, prints() + pos, total - pos);
+            set_print(pos, fp);
+            count = static_cast<word_u16::word_type>(total + 1);
+            return true;
+        }
+
+        bool erase_print(std::size_t pos) noexcept {
+            const std::size_t total = count.get();
+            if (pos >= total) {
+                return false;
+            }
+            std::memmove(prints() + pos, prints() + pos + 1, total - pos - 1);
+            count = static_cast<word_u16::word_type>(total - 1);
+            return true;
+        }
+    } FULLA_PACKED;
+
+    // Leaf and inode block of models with prefix_keys, right after the node subheader: up to
+    // `capacity` bytes of the first key stored into the empty page. A slot key starts with
+    // one byte, the number of prefix bytes the key begins with, followed by the rest of the
+    // key; keys sharing a long head with their neighbours keep only what differs.
+    struct bpt_key_prefix {
+        constexpr static const std::size_t maximum_len = 255;
+        constexpr static const std::uint16_t tag_value = 0x5850; // "PX"
+
+        word_u16 tag{ 0 };
+        word_u16 capacity{ 0 };
+        word_u16 len{ 0 };
+        word_u16 reserved{ 0 };
+
+        constexpr static std::size_t bytes_for(std::size_t len) noexcept {
+            return sizeof(bpt_key_prefix) + std::min(len, maximum_len);
+        }
+
+        void init(std::size_t len_limit) {
+            tag = tag_value;
+            capacity = static_cast<word_u16::word_type>(std::min(len_limit, maximum_len));
+            len = 0;
+        }
+
+        std::size_t block_size() const noexcept {
+            return bytes_for(capacity.get());
+        }
+
+        core::byte* bytes() noexcept {
+            return reinterpret_cast<core::byte*>(this) + sizeof(bpt_key_prefix);
+        }
+
+        const core::byte* bytes() const noexcept {
+            return reinterpret_cast<const core::byte*>(this) + sizeof(bpt_key_prefix);
+        }
+
+        core::byte_view view() const noexcept {
+            return { bytes(), len.get() };
+        }
+
+        void assign(core::byte_view key) noexcept {
+            const auto n = std::min<std::size_t>(key.size(), capacity.get());
+            if (n > 0) {
+                std::memcpy(bytes(), key.data(), n);
+            }
+            len = static_cast<word_u16::word_type>(n);
+        }
+
+        // Number of leading bytes `key` shares with `prefix`.
+        static std::size_t shared(core::byte_view prefix, core::byte_view key) noexcept {
+            return static_cast<std::size_t>(std::ranges::mismatch(prefix, key).in1 - prefix.begin());
+        }
+
+        std::size_t shared(core::byte_view key) const noexcept {
+            return shared(view(), key);
+        }
+    } FULLA_PACKED;
+
+FULLA_PACKED_STRUCT_END
+}
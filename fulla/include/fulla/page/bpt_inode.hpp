@@ -26,6 +26,22 @@ FULLA_PACKED_STRUCT_BEGIN
         }
     } FULLA_PACKED;
 
+    // Inode subheader of trees with inode right-links or child counts. `next` is the
+    // right-link to the following inode of the same level (B-link tree); `rightmost_count`
+    // is the element count of the rightmost child (bpt_inode_counted_slot).
+    struct bpt_inode_wide_header {
+        word_u32 parent {0};
+        word_u32 rightmost_child {0};
+        word_u32 next {0};
+        word_u32 rightmost_count {0};
+        void init() {
+            parent = 0;
+            rightmost_child = 0;
+            next = 0;
+            rightmost_count = 0;
+        }
+    } FULLA_PACKED;
+
     struct bpt_inode_slot {
         word_u32 child {0};
         static typename word_u16::word_type key_offset() {
@@ -33,5 +49,15 @@ FULLA_PACKED_STRUCT_BEGIN
         }
     } FULLA_PACKED;
 
+    // Slot of trees that keep order statistics: `count` is the number of elements
+    // stored under `child`.
+    struct bpt_inode_counted_slot {
+        word_u32 child {0};
+        word_u32 count {0};
+        static typename word_u16::word_type key_offset() {
+            return sizeof(bpt_inode_counted_slot);
+        }
+    } FULLA_PACKED;
+
 FULLA_PACKED_STRUCT_END
 }
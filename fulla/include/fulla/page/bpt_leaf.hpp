@@ -15,6 +15,7 @@ namespace fulla::page {
 
     using core::word_u16;
     using core::word_u32;
+    using core::word_u64;
 
     using pid_type = word_u32;
     using pid_value_type = typename pid_type::word_type;
@@ -35,6 +36,9 @@ FULLA_PACKED_STRUCT_BEGIN
     } FULLA_PACKED;
 
     struct bpt_leaf_slot {
+        // the top bit of value_off marks a value kept out of line (bpt_leaf_external_value)
+        constexpr static const word_u16::word_type external_flag = 0x8000;
+
         word_u16 key_len{ 0 };
         word_u16 value_off{ 0 };
         
@@ -43,7 +47,16 @@ FULLA_PACKED_STRUCT_BEGIN
         }
         
         word_u16::word_type value_offset() const {
-            return value_off;
+            return static_cast<word_u16::word_type>(value_off.get() & ~external_flag);
+        }
+
+        bool is_external() const {
+            return (value_off.get() & external_flag) != 0;
+        }
+
+        void set_external(bool on) {
+            const auto offset = value_offset();
+            value_off = static_cast<word_u16::word_type>(on ? (offset | external_flag) : offset);
         }
 
         void update(std::size_t new_key_len) {
@@ -57,6 +70,12 @@ FULLA_PACKED_STRUCT_BEGIN
 
     } FULLA_PACKED;
 
+    // The value part of a leaf slot whose value lives in a long_store chain.
+    struct bpt_leaf_external_value {
+        word_u32 header{ 0 };
+        word_u64 size{ 0 };
+    } FULLA_PACKED;
+
 FULLA_PACKED_STRUCT_END
 
 }
@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <compare>
 #include <concepts>
+#include <cstring>
 
 #include "fulla/core/bytes.hpp"
 #include "fulla/page/page_view.hpp"
@@ -33,6 +35,32 @@ namespace fulla::page {
         }
     };
 
+    // Plain lexicographic byte order (memcmp). For keys stored with an order-preserving
+    // encoding. Every key in a sorted page then shares the common prefix of the first
+    // and the last key, which lets searches skip it.
+    struct bytewise_less {
+        constexpr static const bool bytewise_order = true;
+
+        bool operator()(byte_view a, byte_view b) const noexcept {
+            return std::is_lt(compare(a, b));
+        }
+
+        std::strong_ordering compare(byte_view a, byte_view b) const noexcept {
+            const auto common = std::min(a.size(), b.size());
+            if (common > 0) {
+                if (const int res = std::memcmp(a.data(), b.data(), common); res != 0) {
+                    return res <=> 0;
+                }
+            }
+            return a.size() <=> b.size();
+        }
+    };
+
+    template <typename KeyLessT>
+    concept BytewiseKeyLess = requires {
+        requires KeyLessT::bytewise_order;
+    };
+
     template <typename SlotExtractorT>
     concept SlotExtractorConcept = requires(SlotExtractorT se) {
         { se.operator ()(byte_view{}) } -> std::convertible_to<byte_view>;
@@ -44,6 +44,9 @@ namespace fulla::page_allocator {
         void flush(pid_type pid) { return mgr_.flush(pid); }
         void flush_all() { return mgr_.flush_all(); }
 
+        std::size_t maximum_pages() const noexcept { return mgr_.maximum_pages(); }
+        std::size_t resize(std::size_t maximum_pages) { return mgr_.resize(maximum_pages); }
+
         virtual page_handle allocate() { return mgr_.allocate(); }
         virtual void destroy(pid_type) {}
 
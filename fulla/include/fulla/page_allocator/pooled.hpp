@@ -0,0 +1,65 @@
+/*
+ * File: page_allocator/pooled.hpp
+ * Author: newenclave
+ * GitHub: https://github.com/newenclave
+ * Created: 2026-10-16
+ * License: MIT
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+#include "fulla/storage/block_device.hpp"
+#include "fulla/storage/buffer_pool.hpp"
+#include "fulla/page_allocator/concepts.hpp"
+
+namespace fulla::page_allocator {
+
+    using namespace fulla::storage;
+
+    /// Page allocator for one device on top of a shared buffer_pool.
+    template <RandomAccessBlockDevice RadT, typename PidT = std::uint32_t>
+    class pooled {
+    public:
+        using pid_type = PidT;
+        using underlying_device_type = RadT;
+        using buffer_pool_type = storage::buffer_pool<RadT, PidT>;
+        using device_id_type = typename buffer_pool_type::device_id_type;
+        using page_handle = typename buffer_pool_type::page_handle;
+
+        constexpr static const pid_type invalid_pid = std::numeric_limits<pid_type>::max();
+
+        pooled(buffer_pool_type& pool, underlying_device_type& device)
+            : pool_(&pool)
+            , device_id_(pool.attach(device))
+        {}
+
+        pooled(const pooled&) = delete;
+        pooled& operator = (const pooled&) = delete;
+
+        virtual ~pooled() {
+            pool_->detach(device_id_);
+        }
+
+        buffer_pool_type& pool() noexcept { return *pool_; }
+        device_id_type device_id() const noexcept { return device_id_; }
+
+        underlying_device_type& underlying_device() { return pool_->device(device_id_); }
+        std::size_t page_size() const noexcept { return pool_->page_size(); }
+        std::size_t pages_count() noexcept { return underlying_device().blocks_count(); }
+
+        bool valid_id(pid_type pid) const { return pool_->valid_id(device_id_, pid); }
+        auto fetch(pid_type pid) { return pool_->fetch(device_id_, pid); }
+        void flush(pid_type pid) { return pool_->flush(device_id_, pid); }
+        void flush_all() { return pool_->flush_all(device_id_); }
+
+        virtual page_handle allocate() { return pool_->allocate(device_id_); }
+        virtual void destroy(pid_type) {}
+
+    private:
+        buffer_pool_type* pool_;
+        device_id_type device_id_;
+    };
+}
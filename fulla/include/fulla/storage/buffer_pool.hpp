@@ -0,0 +1,233 @@
+/*
+ * File: buffer_pool.hpp
+ * Author: newenclave
+ * GitHub: https://github.com/newenclave
+ * Created: 2026-10-16
+ * License: MIT
+ */
+
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <memory>
+#include <functional>
+
+#include "fulla/core/bytes.hpp"
+#include "fulla/core/debug.hpp"
+#include "fulla/storage/block_device.hpp" // RandomAccessBlockDevice
+#include "fulla/storage/frame_cache.hpp"
+
+namespace fulla::storage {
+
+	namespace detail {
+
+		template <typename PidT>
+		struct pool_page_key {
+			using device_id_type = std::uint32_t;
+			constexpr static const device_id_type invalid_device_id = std::numeric_limits<device_id_type>::max();
+			device_id_type device_id = invalid_device_id;
+			PidT pid = std::numeric_limits<PidT>::max();
+			friend bool operator == (const pool_page_key&, const pool_page_key&) = default;
+		};
+
+		template <typename PidT>
+		struct pool_page_key_hash {
+			std::size_t operator ()(const pool_page_key<PidT>& key) const noexcept {
+				const auto h0 = std::hash<typename pool_page_key<PidT>::device_id_type>{}(key.device_id);
+				const auto h1 = std::hash<PidT>{}(key.pid);
+				return h0 ^ (h1 + 0x9e3779b9 + (h0 << 6) + (h0 >> 2));
+			}
+		};
+	}
+
+	/// A buffer pool shared by several block devices.
+	/// Pages are identified by (device id, pid); all attached devices compete
+	/// for the same frames under one LRU replacement policy.
+	template <storage::RandomAccessBlockDevice RadT, typename PidT = std::uint32_t>
+	class buffer_pool: public frame_cache<buffer_pool<RadT, PidT>, detail::pool_page_key<PidT>, detail::pool_page_key_hash<PidT>> {
+		using base_type = frame_cache<buffer_pool<RadT, PidT>, detail::pool_page_key<PidT>, detail::pool_page_key_hash<PidT>>;
+		friend base_type;
+	public:
+
+		using pid_type = PidT;
+		using page_key = detail::pool_page_key<PidT>;
+		using device_id_type = typename page_key::device_id_type;
+		using underlying_device_type = RadT;
+		using frame = typename base_type::frame;
+
+		constexpr static const pid_type invalid_pid = std::numeric_limits<pid_type>::max();
+		constexpr static const device_id_type invalid_device_id = page_key::invalid_device_id;
+
+		struct page_handle: public base_type::basic_page_handle {
+
+			using pid_type = PidT;
+			using base_handle = typename base_type::basic_page_handle;
+
+			page_handle() = default;
+
+			explicit page_handle(frame* s)
+				: base_handle(s)
+			{}
+
+			pid_type pid() const noexcept {
+				if (this->has_frame()) {
+					return this->frame_->key.pid;
+				}
+				return invalid_pid;
+			}
+
+			device_id_type device_id() const noexcept {
+				if (this->has_frame()) {
+					return this->frame_->key.device_id;
+				}
+				return invalid_device_id;
+			}
+
+			bool is_valid() const noexcept {
+				return pid() != invalid_pid;
+			}
+		};
+
+		buffer_pool(std::size_t page_size, std::size_t maximum_pages)
+			: page_size_(page_size)
+		{
+			this->grow(maximum_pages);
+		}
+
+		buffer_pool() = delete;
+		buffer_pool(const buffer_pool&) = delete;
+		buffer_pool& operator = (const buffer_pool&) = delete;
+		~buffer_pool() {
+			this->flush_all();
+		}
+
+		/// Registers a device in the pool. The device must use the pool page size.
+		device_id_type attach(underlying_device_type& device) {
+			DB_ASSERT(device.block_size() == page_size_, "Device block size must match the pool page size");
+			auto free_slot = std::ranges::find(devices_, nullptr);
+			if (free_slot != devices_.end()) {
+				*free_slot = &device;
+				return static_cast<device_id_type>(std::distance(devices_.begin(), free_slot));
+			}
+			devices_.emplace_back(&device);
+			return static_cast<device_id_type>(devices_.size() - 1);
+		}
+
+		/// Flushes and drops all pages of the device. None of them can be pinned.
+		void detach(device_id_type device_id) {
+			if (!valid_device_id(device_id)) {
+				return;
+			}
+			this->evict_if([device_id](const page_key& key) { return key.device_id == device_id; });
+			devices_[device_id] = nullptr;
+		}
+
+		bool valid_device_id(device_id_type device_id) const noexcept {
+			return (device_id < devices_.size()) && (devices_[device_id] != nullptr);
+		}
+
+		bool valid_id(device_id_type device_id, pid_type pid) const {
+			return valid_device_id(device_id) && (pid < devices_[device_id]->blocks_count());
+		}
+
+		underlying_device_type& device(device_id_type device_id) noexcept {
+			DB_ASSERT(valid_device_id(device_id), "Bad device id");
+			return *devices_[device_id];
+		}
+
+		const underlying_device_type& device(device_id_type device_id) const noexcept {
+			DB_ASSERT(valid_device_id(device_id), "Bad device id");
+			return *devices_[device_id];
+		}
+
+		page_handle allocate(device_id_type device_id) {
+			return create(device_id, true);
+		}
+
+		page_handle create(device_id_type device_id, bool mark_dirty = false) {
+			if (!valid_device_id(device_id)) {
+				return {};
+			}
+			if (auto* fs = this->find_free_frame()) {
+				const auto new_bid = devices_[device_id]->allocate_block();
+
+				if (new_bid == RadT::invalid_block_id) {
+					this->release_frame(fs);
+					return {};
+				}
+
+				this->install_frame(fs, page_key{ device_id, static_cast<pid_type>(new_bid) });
+				if (mark_dirty) {
+					fs->make_dirty();
+				}
+				return page_handle(fs);
+			}
+			return {};
+		}
+
+		page_handle fetch(device_id_type device_id, pid_type pid) {
+			if ((pid == invalid_pid) || !valid_device_id(device_id)) {
+				return {};
+			}
+			const page_key key{ device_id, pid };
+			if (auto* fs = this->find_cached(key)) {
+				return page_handle(fs);
+			}
+			if (auto* fs = this->find_free_frame()) {
+				const auto ok = read(key, fs->buffer());
+				if (ok) {
+					this->install_frame(fs, key);
+					return page_handle(fs);
+				}
+				else {
+					this->release_frame(fs);
+				}
+			}
+			return {};
+		}
+
+		void flush(device_id_type device_id, pid_type pid) {
+			if (auto itr = this->cache_.find(page_key{ device_id, pid }); itr != this->cache_.end()) {
+				this->flush_frame(itr->second);
+			}
+		}
+
+		void flush_all(device_id_type device_id) {
+			this->flush_if([device_id](const page_key& key) { return key.device_id == device_id; });
+		}
+
+		using base_type::flush_all;
+
+		void evict(device_id_type device_id, pid_type pid) {
+			this->evict_key(page_key{ device_id, pid }, true);
+		}
+
+		using base_type::resident_pages;
+
+		std::size_t resident_pages(device_id_type device_id) const noexcept {
+			return this->count_if([device_id](const page_key& key) { return key.device_id == device_id; });
+		}
+
+		std::size_t page_size() const noexcept {
+			return page_size_;
+		}
+
+	PRIVATE_TESTABLE:
+
+		bool write_frame(const page_key& key, core::byte_view data) {
+			return devices_[key.device_id]->write_block(key.pid, data.data(), data.size());
+		}
+
+		bool read(const page_key& key, core::byte_span data) {
+			return devices_[key.device_id]->read_block(key.pid, data.data(), data.size());
+		}
+
+		std::size_t page_size_ = 0;
+		std::vector<underlying_device_type*> devices_;
+	};
+
+} // namespace fulla::storage
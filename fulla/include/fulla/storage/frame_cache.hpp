@@ -0,0 +1,465 @@
+/*
+ * File: frame_cache.hpp
+ * Author: newenclave
+ * GitHub: https://github.com/newenclave
+ * Created: 2026-10-16
+ * License: MIT
+ */
+
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <functional>
+
+#include "fulla/core/bytes.hpp"
+#include "fulla/core/debug.hpp"
+
+namespace fulla::storage {
+
+	/// Frames, pin counts and LRU replacement shared by buffer_manager and buffer_pool.
+	/// DerivedT supplies the device side:
+	///   std::size_t page_size() const;
+	///   bool write_frame(const KeyT&, core::byte_view);
+	/// Pages are identified by KeyT; the owner decides how a key maps to a device block.
+	template <typename DerivedT, typename KeyT, typename KeyHashT = std::hash<KeyT>>
+	class frame_cache {
+	public:
+
+		using key_type = KeyT;
+
+		struct frame {
+
+			frame() = default;
+			explicit frame(std::size_t page_size)
+				: storage(page_size)
+			{}
+			frame(const frame&) = delete;
+			frame& operator = (const frame&) = delete;
+			frame(frame&&) = delete;
+			frame& operator = (frame&&) = delete;
+
+			void reset() {
+				dirty = false;
+				used = false;
+				key = {};
+				ref_count = 0;
+			}
+
+			void reinit(const key_type& k) {
+				dirty = false;
+				used = true;
+				key = k;
+				ref_count = 0;
+				++gen;
+			}
+
+			void make_dirty() {
+				dirty = true;
+			}
+
+			void ref() {
+				++ref_count;
+			}
+
+			void unref() {
+				DB_ASSERT(ref_count > 0, "Trying to unfer zero");
+				--ref_count;
+			}
+
+			bool is_valid() const noexcept {
+				return used;
+			}
+
+			core::byte_span buffer() noexcept {
+				return { storage.data(), storage.size() };
+			}
+
+			bool dirty = false;
+			bool used = false;
+			key_type key{};
+			std::size_t ref_count = 0;
+			std::size_t gen = 1;
+			core::byte_buffer storage;
+			frame* next = nullptr;
+			frame* prev = nullptr;
+		};
+
+		/// Pins a frame for its lifetime. Owners derive their page_handle from it
+		/// and translate the key into pid/device accessors.
+		struct basic_page_handle {
+
+			basic_page_handle() = default;
+
+			basic_page_handle(const basic_page_handle& other) noexcept {
+				copy_impl(other);
+			}
+
+			basic_page_handle& operator = (const basic_page_handle& other) noexcept {
+				copy_impl(other);
+				return *this;
+			}
+
+			basic_page_handle(basic_page_handle&& other) noexcept {
+				move_impl(std::move(other));
+			}
+
+			basic_page_handle& operator = (basic_page_handle&& other) noexcept {
+				move_impl(std::move(other));
+				return *this;
+			}
+
+			explicit basic_page_handle(frame* s)
+				: frame_(s)
+			{
+				if (frame_) {
+					gen_ = frame_->gen;
+					frame_->ref();
+				}
+			}
+
+			~basic_page_handle() noexcept {
+				unref();
+			}
+
+			bool has_frame() const noexcept {
+				return (frame_ != nullptr) && frame_->is_valid();
+			}
+
+			void mark_dirty() {
+				if (frame_) {
+					frame_->make_dirty();
+				}
+			}
+
+			core::byte_span rw_span() noexcept {
+				if (frame_) {
+					DB_ASSERT(check_slot_gen(), "Bad slot");
+					return frame_->buffer();
+				}
+				return {};
+			}
+
+			core::byte_view ro_span() const noexcept {
+				if (frame_) {
+					DB_ASSERT(check_slot_gen(), "Bad slot");
+					return { frame_->storage.data(), frame_->storage.size() };
+				}
+				return {};
+			}
+
+			friend bool operator == (const basic_page_handle& lhs, const basic_page_handle& rhs) {
+				return (lhs.frame_ == rhs.frame_);
+			}
+
+			bool check_slot_gen() const noexcept {
+				if (frame_) {
+					return frame_->gen == gen_;
+				}
+				// empty slot, no check
+				return true;
+			}
+
+			void copy_impl(const basic_page_handle& other) noexcept {
+				if (this != &other) {
+					unref();
+					reset();
+					if (other.frame_) {
+						frame_ = other.frame_;
+						gen_ = other.gen_;
+						ref();
+					}
+				}
+			}
+
+			void move_impl(basic_page_handle&& other) noexcept {
+				if (this != &other) {
+					unref();
+					reset();
+					if (other.frame_) {
+						frame_ = other.frame_;
+						gen_ = other.gen_;
+						other.reset();
+					}
+				}
+			}
+
+			void ref() {
+				if (frame_) {
+					DB_ASSERT(check_slot_gen(), "Bad slot");
+					frame_->ref();
+				}
+			}
+
+			void unref() {
+				if (frame_) {
+					DB_ASSERT(check_slot_gen(), "Bad slot");
+					frame_->unref();
+				}
+			}
+
+			void reset() {
+				frame_ = nullptr;
+				gen_ = 0;
+			}
+
+			frame* frame_ = nullptr;
+			std::size_t gen_ = 0;
+		};
+
+		using cache_map_type = std::unordered_map<key_type, frame*, KeyHashT>;
+		using frame_ptr = std::unique_ptr<frame>;
+
+		std::size_t resident_pages() const noexcept {
+			return cache_.size();
+		}
+
+		std::size_t maximum_pages() const noexcept {
+			return frames_.size();
+		}
+
+		/// Changes the number of frames at runtime.
+		/// Growing adds empty frames. Shrinking releases free frames first, then
+		/// evicts unpinned pages starting from the least recently used one.
+		/// Pinned pages are never released, so the result can stay above
+		/// `new_maximum_pages`. Returns the resulting number of frames.
+		std::size_t resize(std::size_t new_maximum_pages) {
+			if (new_maximum_pages > frames_.size()) {
+				grow(new_maximum_pages - frames_.size());
+			}
+			else if (new_maximum_pages < frames_.size()) {
+				shrink(frames_.size() - new_maximum_pages);
+			}
+			return frames_.size();
+		}
+
+		std::size_t evict_inactive() {
+			std::size_t count = 0;
+			for (auto& s : frames_) {
+				if ((s->ref_count == 0) && s->is_valid()) {
+					evict_key(s->key, true);
+					count++;
+				}
+			}
+			return count;
+		}
+
+		bool has_free_frames() const noexcept {
+			for (auto& s : frames_) {
+				if ((s->ref_count == 0) || !s->is_valid()) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void flush_all() {
+			std::ranges::for_each(frames_, [this](auto& frame) { flush_frame(frame.get()); });
+		}
+
+	protected:
+
+		frame_cache() = default;
+		frame_cache(frame_cache&&) = default;
+		frame_cache& operator = (frame_cache&&) = default;
+		frame_cache(const frame_cache&) = delete;
+		frame_cache& operator = (const frame_cache&) = delete;
+		~frame_cache() = default;
+
+		DerivedT& self() noexcept {
+			return static_cast<DerivedT&>(*this);
+		}
+
+		/// Returns the cached frame for the key and moves it to the LRU head.
+		frame* find_cached(const key_type& key) {
+			if (auto itr = cache_.find(key); itr != cache_.end()) {
+				auto fs = itr->second;
+				pop_frame_from_list(fs);
+				push_frame_used(fs);
+				return fs;
+			}
+			return nullptr;
+		}
+
+		/// Binds a frame taken from find_free_frame to the key.
+		void install_frame(frame* fs, const key_type& key) {
+			fs->reinit(key);
+			push_frame_used(fs);
+			cache_[key] = fs;
+		}
+
+		/// Returns a frame taken from find_free_frame unused.
+		void release_frame(frame* fs) {
+			fs->reset();
+			push_frame_freed(fs);
+		}
+
+		/// Drops the page from the cache and unlinks its frame from the LRU list.
+		/// With `push_free` the frame goes to the free list, otherwise the caller keeps it.
+		void evict_key(const key_type& key, bool push_free) {
+			auto itr = cache_.find(key);
+			if (itr != cache_.end()) {
+				auto fs = itr->second;
+
+				DB_ASSERT(fs->ref_count == 0, "Trying to evict a pinned page");
+
+				pop_frame_from_list(fs);
+				flush_frame(fs);
+				fs->reset();
+				cache_.erase(itr);
+				if (push_free) {
+					push_frame_freed(fs);
+				}
+			}
+		}
+
+		void flush_frame(frame* fs) {
+			if (fs->dirty && fs->is_valid()) {
+				const auto ok = self().write_frame(fs->key, fs->buffer());
+				if (ok) {
+					fs->dirty = false;
+				}
+			}
+		}
+
+		template <typename PredT>
+		void flush_if(PredT&& pred) {
+			for (auto& s : frames_) {
+				if (s->is_valid() && pred(s->key)) {
+					flush_frame(s.get());
+				}
+			}
+		}
+
+		/// Evicts every resident page whose key matches. None of them can be pinned.
+		template <typename PredT>
+		void evict_if(PredT&& pred) {
+			for (auto& s : frames_) {
+				if (s->is_valid() && pred(s->key)) {
+					evict_key(s->key, true);
+				}
+			}
+		}
+
+		template <typename PredT>
+		std::size_t count_if(PredT&& pred) const {
+			return static_cast<std::size_t>(std::ranges::count_if(frames_, [&pred](const auto& s) {
+				return s->is_valid() && pred(s->key);
+			}));
+		}
+
+		void grow(std::size_t count) {
+			frames_.reserve(frames_.size() + count);
+			for (std::size_t i = 0; i < count; ++i) {
+				frames_.emplace_back(std::make_unique<frame>(self().page_size()));
+				push_frame_freed(frames_.back().get());
+			}
+		}
+
+		void shrink(std::size_t count) {
+			std::size_t released = 0;
+			while ((released < count) && first_freed_) {
+				auto fs = first_freed_;
+				pop_frame_from_list(fs);
+				fs->next = fs; // marks the frame as released
+				++released;
+			}
+			auto last = last_used_;
+			while ((released < count) && last) {
+				auto prev = last->prev;
+				if (last->ref_count == 0) {
+					evict_key(last->key, false);
+					last->next = last;
+					++released;
+				}
+				last = prev;
+			}
+			std::erase_if(frames_, [](const frame_ptr& fs) { return fs->next == fs.get(); });
+		}
+
+		void push_frame_freed(frame* s) {
+			if (first_freed_) {
+				first_freed_->prev = s;
+			}
+			s->next = first_freed_;
+			first_freed_ = s;
+			first_freed_->prev = nullptr;
+		}
+
+		void push_frame_used(frame* s) {
+			if (first_used_) {
+				first_used_->prev = s;
+			}
+			s->next = first_used_;
+			first_used_ = s;
+			first_used_->prev = nullptr;
+			if (nullptr == last_used_) {
+				last_used_ = first_used_;
+			}
+		}
+
+		void pop_frame_from_list(frame* s) {
+			auto next = s->next;
+			auto prev = s->prev;
+			if (next) {
+				next->prev = prev;
+			}
+			if (prev) {
+				prev->next = next;
+			}
+			if (s == first_used_) {
+				first_used_ = next;
+			}
+			if (s == last_used_) {
+				last_used_ = prev;
+			}
+			if (s == first_freed_) {
+				first_freed_ = next;
+			}
+			s->next = s->prev = nullptr;
+		}
+
+		frame* find_free_frame() {
+
+			if (auto freed = try_pop_freed_frame()) {
+				return freed;
+			}
+
+			if (auto first = try_find_first_available()) {
+				return first;
+			}
+
+			return nullptr;
+		}
+
+		frame* try_pop_freed_frame() {
+			if (first_freed_) {
+				auto s = first_freed_;
+				pop_frame_from_list(s);
+				return s;
+			}
+			return nullptr;
+		}
+
+		frame* try_find_first_available() {
+			auto last = last_used_;
+			while (last) {
+				if (last->ref_count == 0) {
+					evict_key(last->key, false);
+					return last;
+				}
+				last = last->prev;
+			}
+			return nullptr;
+		}
+
+		cache_map_type cache_;
+		std::vector<frame_ptr> frames_;
+		frame* first_used_ = nullptr;
+		frame* last_used_ = nullptr;
+		frame* first_freed_ = nullptr;
+	};
+
+} // namespace fulla::storage
@@ -0,0 +1,298 @@
+// tests/test_bpt_fixed_model.cpp
+#include "tests.hpp"
+
+#include "fulla/core/simd.hpp"
+#include "fulla/bpt/paged/fixed_model.hpp"
+#include "fulla/bpt/tree.hpp"
+#include "fulla/storage/memory_block_device.hpp"
+#include "fulla/storage/buffer_manager.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace fulla::core;
+using namespace fulla::storage;
+using namespace fulla::bpt;
+
+namespace {
+
+    constexpr static const auto DEFAULT_BUFFER_SIZE = 4096UL;
+
+    template <typename T>
+    void check_bounds(std::mt19937_64& rng, std::size_t count, std::uint64_t spread) {
+        // values in [0, range) shifted down by half the spread for signed T; the
+        // arithmetic stays in 64 bits, the narrowing cast wraps
+        const auto draw = [&](std::uint64_t range, std::uint64_t shift) {
+            const auto offset = static_cast<std::int64_t>(std::is_signed_v<T> ? shift : 0);
+            return static_cast<T>(static_cast<std::int64_t>(rng() % range) - offset);
+        };
+        std::vector<T> values(count);
+        for (auto& v : values) {
+            v = draw(spread, spread / 2);
+        }
+        std::ranges::sort(values);
+        const auto* data = reinterpret_cast<const byte*>(values.data());
+
+        auto probe = [&](T key) {
+            const auto lb = static_cast<std::size_t>(std::ranges::lower_bound(values, key) - values.begin());
+            const auto ub = static_cast<std::size_t>(std::ranges::upper_bound(values, key) - values.begin());
+            CHECK(simd::lower_bound<T>(data, values.size(), key) == lb);
+            CHECK(simd::upper_bound<T>(data, values.size(), key) == ub);
+        };
+        for (int i = 0; i < 200; ++i) {
+            probe(draw(spread + 2, spread / 2 + 1));
+        }
+        probe(std::numeric_limits<T>::min());
+        probe(std::numeric_limits<T>::max());
+        for (auto v : values) {
+            probe(v);
+        }
+    }
+
+    // No node below the root may hold fewer entries than rebalancing keeps in a node.
+    template <typename Tree>
+    void check_min_fill(Tree& t, typename Tree::node_id_type id, bool is_root = true) {
+        auto check_node = [is_root](const auto& node) {
+            CHECK((is_root || node.size() >= (node.capacity() + 1) / 2 - 1));
+        };
+        if (t.get_model().is_leaf_id(id)) {
+            check_node(t.get_accessor().load_leaf(id));
+            return;
+        }
+        auto inode = t.get_accessor().load_inode(id);
+        check_node(inode);
+        for (std::size_t i = 0; i <= inode.size(); ++i) {
+            check_min_fill(t, inode.get_child(i), false);
+        }
+    }
+
+    template <typename Tree>
+    void check_min_fill(Tree& t) {
+        if (auto [root, exists] = t.get_accessor().load_root(); exists) {
+            check_min_fill(t, root);
+        }
+    }
+
+    template <typename T>
+    void check_bounds() {
+        std::mt19937_64 rng(0x51D0 + sizeof(T));
+        for (std::size_t count : { 0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 100, 511 }) {
+            check_bounds<T>(rng, count, 64);
+            check_bounds<T>(rng, count, std::numeric_limits<std::uint32_t>::max());
+        }
+    }
+}
+
+TEST_SUITE("bpt/paged fixed model") {
+
+    TEST_CASE("simd bounds match std::lower_bound and std::upper_bound") {
+        check_bounds<std::uint32_t>();
+        check_bounds<std::int32_t>();
+        check_bounds<std::uint64_t>();
+        check_bounds<std::int64_t>();
+
+        // the sign bias: unsigned words above INT_MAX stay above the small ones
+        const std::array<std::uint32_t, 9> words = { 0, 1, 2, 3, 0x7FFFFFFF, 0x80000000, 0x80000001, 0xFFFFFFF0, 0xFFFFFFFF };
+        const auto* data = reinterpret_cast<const byte*>(words.data());
+        CHECK(simd::lower_bound<std::uint32_t>(data, words.size(), 0x80000000) == 5);
+        CHECK(simd::upper_bound<std::uint32_t>(data, words.size(), 0xFFFFFFF0) == 8);
+
+        // 64-bit words that differ only in one half
+        const std::array<std::int64_t, 8> wide = { -0x100000000, -1, 0, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0x100000000, 0x180000000 };
+        const auto* wide_data = reinterpret_cast<const byte*>(wide.data());
+        for (std::size_t i = 0; i < wide.size(); ++i) {
+            CHECK(simd::lower_bound<std::int64_t>(wide_data, wide.size(), wide[i]) == i);
+            CHECK(simd::upper_bound<std::int64_t>(wide_data, wide.size(), wide[i]) == i + 1);
+            CHECK(simd::lower_bound<std::uint64_t>(wide_data + 2 * sizeof(std::int64_t), wide.size() - 2,
+                static_cast<std::uint64_t>(wide[i])) == ((i >= 2) ? i - 2 : wide.size() - 2));
+        }
+    }
+
+    TEST_CASE("simd find_byte reports every match in order") {
+        std::mt19937 rng(0xB17E);
+        for (std::size_t count : { 0, 1, 15, 16, 17, 31, 32, 33, 100, 255 }) {
+            std::vector<byte> data(count);
+            for (auto& b : data) {
+                b = static_cast<byte>(rng() % 4);
+            }
+            for (std::uint8_t value = 0; value < 5; ++value) {
+                std::vector<std::size_t> expected;
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (static_cast<std::uint8_t>(data[i]) == value) {
+                        expected.push_back(i);
+                    }
+                }
+                std::vector<std::size_t> found;
+                CHECK_FALSE(simd::find_byte(data.data(), count, value, [&](std::size_t i) {
+                    found.push_back(i);
+                    return false;
+                }));
+                CHECK(found == expected);
+                if (!expected.empty()) {
+                    std::size_t first = count;
+                    CHECK(simd::find_byte(data.data(), count, value, [&](std::size_t i) {
+                        first = i;
+                        return true;
+                    }));
+                    CHECK(first == expected.front());
+                }
+            }
+        }
+    }
+
+    TEST_CASE("u64 keys: insert, find, remove against std::map") {
+        memory_block_device mem(DEFAULT_BUFFER_SIZE);
+        using BM = buffer_manager<memory_block_device>;
+        using model_type = paged::fixed_model<BM, std::uint64_t, std::uint64_t>;
+        using bpt_type = tree<model_type>;
+        BM bm(mem, 16);
+        bpt_type bpt(bm);
+
+        std::mt19937_64 rng(0xF1ED);
+        std::map<std::uint64_t, std::uint64_t> test;
+        while (test.size() < 20000) {
+            const auto k = rng();
+            if (!test.contains(k)) {
+                REQUIRE(bpt.insert({ k }, { k ^ 0xABCD }));
+                test[k] = k ^ 0xABCD;
+            }
+        }
+        CHECK_FALSE(bpt.insert({ test.begin()->first }, { 0 }));
+
+        auto it = bpt.begin();
+        for (auto& [k, v] : test) {
+            REQUIRE(it != bpt.end());
+            CHECK(it->first.key == k);
+            CHECK(it->second.val == v);
+            ++it;
+        }
+        CHECK(it == bpt.end());
+
+        std::size_t erased = 0;
+        for (auto itr = test.begin(); itr != test.end();) {
+            if (erased++ % 3 != 0) {
+                REQUIRE(bpt.remove({ itr->first }));
+                itr = test.erase(itr);
+            }
+            else {
+                ++itr;
+            }
+        }
+        for (auto& [k, v] : test) {
+            auto found = bpt.find({ k });
+            REQUIRE(found != bpt.end());
+            CHECK(found->second.val == v);
+        }
+        for (int i = 0; i < 100; ++i) {
+            const auto k = rng();
+            if (!test.contains(k)) {
+                CHECK(bpt.find({ k }) == bpt.end());
+            }
+        }
+    }
+
+    TEST_CASE("signed and byte array keys keep their order") {
+        using BM = buffer_manager<memory_block_device>;
+        {
+            memory_block_device mem(DEFAULT_BUFFER_SIZE);
+            BM bm(mem, 16);
+            tree<paged::fixed_model<BM, std::int32_t, std::int32_t>> bpt(bm);
+            for (std::int32_t i = 3000; i >= -3000; --i) {
+                REQUIRE(bpt.insert({ i * 7 }, { i }));
+            }
+            std::int32_t expected = -3000;
+            for (auto it = bpt.begin(); it != bpt.end(); ++it) {
+                CHECK(it->first.key == expected * 7);
+                CHECK(it->second.val == expected);
+                ++expected;
+            }
+            CHECK(expected == 3001);
+            auto lb = bpt.lower_bound({ -20 });
+            REQUIRE(lb != bpt.end());
+            CHECK(lb->first.key == -14);
+        }
+        {
+            using key_type = std::array<std::byte, 6>;
+            memory_block_device mem(DEFAULT_BUFFER_SIZE);
+            BM bm(mem, 16);
+            tree<paged::fixed_model<BM, key_type, std::uint32_t>> bpt(bm);
+
+            std::mt19937 rng(0xA77A);
+            std::map<key_type, std::uint32_t> test;
+            while (test.size() < 5000) {
+                key_type k;
+                for (auto& b : k) {
+                    b = static_cast<std::byte>(rng() % 8);
+                }
+                if (!test.contains(k)) {
+                    const auto v = static_cast<std::uint32_t>(test.size());
+                    REQUIRE(bpt.insert({ k }, { v }));
+                    test[k] = v;
+                }
+            }
+            auto it = bpt.begin();
+            for (auto& [k, v] : test) {
+                REQUIRE(it != bpt.end());
+                CHECK(it->first.key == k);
+                CHECK(it->second.val == v);
+                ++it;
+            }
+        }
+    }
+
+    TEST_CASE("erase_range, split_at and join keep the minimum fill") {
+        // small pages give a deep tree with a few dozen entries per node
+        memory_block_device mem(512);
+        using BM = buffer_manager<memory_block_device>;
+        using model_type = paged::fixed_model<BM, std::uint64_t, std::uint64_t>;
+        using bpt_type = tree<model_type>;
+        BM bm(mem, 32);
+        bpt_type left(bm);
+        bpt_type right(bm);
+
+        std::map<std::uint64_t, std::uint64_t> test;
+        const auto fill = [&](std::uint64_t from, std::uint64_t to) {
+            for (auto k = from; k < to; ++k) {
+                if (!test.contains(k * 2)) {
+                    REQUIRE(left.insert({ k * 2 }, { k }));
+                    test[k * 2] = k;
+                }
+            }
+        };
+        const auto check_same = [&](bpt_type& t, auto first, auto last) {
+            auto it = t.begin();
+            for (; first != last; ++first) {
+                REQUIRE(it != t.end());
+                CHECK(it->first.key == first->first);
+                CHECK(it->second.val == first->second);
+                ++it;
+            }
+            CHECK(it == t.end());
+            check_min_fill(t);
+        };
+
+        fill(0, 20000);
+        std::mt19937_64 rng(0xF111);
+        for (int round = 0; round < 60; ++round) {
+            const auto lo = rng() % 40000;
+            const auto hi = lo + rng() % (round % 2 ? 8000 : 200);
+            test.erase(test.lower_bound(lo), test.lower_bound(hi));
+            left.erase_range({ lo }, { hi });
+            check_same(left, test.begin(), test.end());
+
+            const auto at = rng() % 40000;
+            REQUIRE(left.split_at({ at }, right));
+            check_same(left, test.begin(), test.lower_bound(at));
+            check_same(right, test.lower_bound(at), test.end());
+            REQUIRE(left.join(right));
+            check_same(left, test.begin(), test.end());
+            if (test.size() < 5000) {
+                fill(rng() % 10000, 20000);
+            }
+        }
+    }
+}
@@ -0,0 +1,222 @@
+// tests/test_bpt_locked.cpp
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tests.hpp"
+
+#include "fulla/bpt/locked.hpp"
+#include "fulla/bpt/memory/model.hpp"
+#include "fulla/bpt/paged/model.hpp"
+#include "fulla/storage/buffer_manager.hpp"
+#include "fulla/storage/memory_block_device.hpp"
+
+using namespace fulla::bpt;
+
+namespace {
+
+    template <typename K, typename V, std::size_t MaxKeys = 8>
+    using MemModel = fulla::bpt::memory::model<K, V, MaxKeys>;
+
+    using fulla::core::byte;
+    using fulla::core::byte_view;
+
+    byte_view as_view(const std::string& val) {
+        return { reinterpret_cast<const byte*>(val.data()), val.size() };
+    }
+}
+
+TEST_SUITE("bpt/locked_tree") {
+
+    TEST_CASE("readers share the tree while writers change other keys") {
+        using Model = MemModel<int, std::string>;
+        using Tree = locked_tree<Model>;
+        using key_like_type = typename Model::key_like_type;
+        using value_in_type = typename Model::value_in_type;
+        static_assert(Tree::shared_reads);
+
+        Tree t;
+        constexpr int stable = 2000;
+        for (int i = 0; i < stable; ++i) {
+            std::string v = std::to_string(i);
+            REQUIRE(t.insert(key_like_type{ i }, value_in_type{ v }));
+        }
+
+        std::atomic<bool> stop{ false };
+        std::atomic<std::size_t> misses{ 0 };
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&, r]() {
+                int i = r;
+                while (!stop.load()) {
+                    const int key = i % stable;
+                    const bool found = t.find(key_like_type{ key }, [&](auto k, auto v) {
+                        if (k.get() != key || v.get() != std::to_string(key)) {
+                            ++misses;
+                        }
+                    });
+                    misses += found ? 0 : 1;
+                    i += 7;
+                }
+            });
+        }
+
+        // writers work above the stable range, splitting and merging nodes under the readers
+        std::vector<std::thread> writers;
+        for (int w = 0; w < 2; ++w) {
+            writers.emplace_back([&, w]() {
+                const int base = stable + w * 10000;
+                for (int round = 0; round < 3; ++round) {
+                    for (int i = 0; i < 3000; ++i) {
+                        std::string v = std::to_string(base + i);
+                        t.insert(key_like_type{ base + i }, value_in_type{ v });
+                    }
+                    for (int i = 0; i < 3000; i += (round == 2) ? 2 : 1) {
+                        const int key = base + i;
+                        t.remove(key_like_type{ key });
+                    }
+                }
+            });
+        }
+        for (auto& w : writers) {
+            w.join();
+        }
+        stop = true;
+        for (auto& r : readers) {
+            r.join();
+        }
+        CHECK(misses.load() == 0);
+
+        for (int w = 0; w < 2; ++w) {
+            const int base = stable + w * 10000;
+            for (int i = 0; i < 3000; ++i) {
+                const int key = base + i;
+                CHECK(t.contains(key_like_type{ key }) == (i % 2 == 1));
+            }
+        }
+        const auto total = t.exclusive([](auto& tree) {
+            return static_cast<std::size_t>(std::distance(tree.begin(), tree.end()));
+        });
+        CHECK(total == stable + 2 * 1500);
+    }
+
+    TEST_CASE("models with side-effecting reads serialize lookups") {
+        using namespace fulla::storage;
+        using BM = buffer_manager<memory_block_device>;
+        using model_type = paged::model<BM, fulla::page::bytewise_less>;
+        using Tree = locked_tree<model_type>;
+        static_assert(!Tree::shared_reads);
+
+        memory_block_device mem(4096);
+        BM bm(mem, 16);
+        Tree t(bm);
+
+        std::vector<std::thread> threads;
+        for (int w = 0; w < 4; ++w) {
+            threads.emplace_back([&, w]() {
+                for (int i = 0; i < 1000; ++i) {
+                    const auto key = std::to_string(w) + ":" + std::to_string(i);
+                    t.insert({ as_view(key) }, { as_view(key) });
+                    CHECK(t.find({ as_view(key) }, [&](auto k, auto v) {
+                        CHECK(std::ranges::equal(k.key, as_view(key)));
+                        CHECK(std::ranges::equal(v.val, as_view(key)));
+                    }));
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        for (int w = 0; w < 4; ++w) {
+            for (int i = 0; i < 1000; ++i) {
+                const auto key = std::to_string(w) + ":" + std::to_string(i);
+                CHECK(t.contains({ as_view(key) }));
+            }
+        }
+    }
+
+    TEST_CASE("parallel_for_each visits every key of the range once") {
+        using Model = MemModel<int, int, 6>;
+        using key_like_type = typename Model::key_like_type;
+        using value_in_type = typename Model::value_in_type;
+
+        tree<Model> t;
+        constexpr int count = 20000;
+        for (int i = 0; i < count; ++i) {
+            REQUIRE(t.insert(key_like_type{ i * 2 }, value_in_type{ i }));
+        }
+
+        const auto scan = [&](int lo, int hi, std::size_t threads) {
+            std::vector<std::atomic<int>> seen(count);
+            std::atomic<std::size_t> wrong{ 0 };
+            t.parallel_for_each(key_like_type{ lo }, key_like_type{ hi }, [&](auto k, auto v) {
+                if (k.get() < lo || k.get() >= hi || k.get() != v.get() * 2) {
+                    ++wrong;
+                }
+                ++seen[v.get()];
+            }, threads);
+            CHECK(wrong.load() == 0);
+            for (int i = 0; i < count; ++i) {
+                const int expected = (i * 2 >= lo && i * 2 < hi) ? 1 : 0;
+                if (seen[i].load() != expected) {
+                    FAIL("key " << i * 2 << " seen " << seen[i].load() << " times");
+                }
+            }
+        };
+
+        scan(0, count * 2, 4);
+        scan(-100, count * 4, 8);
+        scan(1001, 30001, 3);
+        scan(5000, 5002, 4);
+        scan(7, 7, 4);
+        scan(0, count * 2, 1);
+    }
+
+    TEST_CASE("parallel_for_each rethrows a worker exception on the caller") {
+        using Model = MemModel<int, int, 6>;
+        using key_like_type = typename Model::key_like_type;
+        using value_in_type = typename Model::value_in_type;
+
+        tree<Model> t;
+        for (int i = 0; i < 20000; ++i) {
+            REQUIRE(t.insert(key_like_type{ i }, value_in_type{ i }));
+        }
+        for (const int bad : { 0, 9999, 19999 }) {
+            CHECK_THROWS_AS(t.parallel_for_each(key_like_type{ 0 }, key_like_type{ 20000 }, [&](auto k, auto) {
+                if (k.get() == bad) {
+                    throw std::runtime_error("bad key");
+                }
+            }, 4), std::runtime_error);
+        }
+    }
+
+    TEST_CASE("parallel_for_each runs the parts in turn on paged models") {
+        using namespace fulla::storage;
+        using BM = buffer_manager<memory_block_device>;
+        using model_type = paged::model<BM, fulla::page::bytewise_less>;
+
+        memory_block_device mem(4096);
+        BM bm(mem, 16);
+        tree<model_type> t(bm);
+
+        std::vector<std::string> keys;
+        for (int i = 0; i < 5000; ++i) {
+            keys.push_back("key:" + std::to_string(100000 + i));
+            REQUIRE(t.insert({ as_view(keys.back()) }, { as_view(keys.back()) }));
+        }
+        const std::string lo = "key:100500";
+        const std::string hi = "key:104000";
+
+        const auto caller = std::this_thread::get_id();
+        std::vector<std::string> visited;
+        t.parallel_for_each({ as_view(lo) }, { as_view(hi) }, [&](auto k, auto v) {
+            CHECK(std::this_thread::get_id() == caller);
+            CHECK(std::ranges::equal(k.key, v.val));
+            visited.emplace_back(reinterpret_cast<const char*>(k.key.data()), k.key.size());
+        }, 4);
+        const std::vector<std::string> expected(keys.begin() + 500, keys.begin() + 4000);
+        CHECK(visited == expected);
+    }
+}
@@ -24,6 +24,12 @@ namespace {
 template <typename K, typename V, std::size_t MaxKeys = 5, typename Less = std::less<void>>
 using MemModel = fulla::bpt::memory::model<K, V, MaxKeys, Less>;
 
+// The same model with per-child element counts in the inodes.
+template <typename K, typename V, std::size_t MaxKeys = 5, typename Less = std::less<void>>
+using CountedMemModel = fulla::bpt::memory::model<K, V, MaxKeys, Less, true>;
+
+static_assert(!fulla::bpt::tree<MemModel<int, int>>::has_child_counts);
+
 template <typename Tree>
 static std::vector<std::pair<typename Tree::key_out_type, typename Tree::value_out_type>>
 collect_all(const Tree& t) {
@@ -34,6 +40,40 @@ collect_all(const Tree& t) {
     return out;
 }
 
+// Every inode entry must hold the number of elements under its child.
+template <typename Tree>
+static std::size_t check_child_counts(Tree& t, typename Tree::node_id_type id) {
+    if (t.get_model().is_leaf_id(id)) {
+        return t.get_accessor().load_leaf(id).size();
+    }
+    auto inode = t.get_accessor().load_inode(id);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i <= inode.size(); ++i) {
+        const auto count = check_child_counts(t, inode.get_child(i));
+        CHECK(inode.get_count(i) == count);
+        total += count;
+    }
+    return total;
+}
+
+// No node below the root may hold fewer entries than rebalancing keeps in a node:
+// (capacity + 1) / 2 - 1, the floor used by merges and borrows.
+template <typename Tree>
+static void check_min_fill(Tree& t, typename Tree::node_id_type id, bool is_root = true) {
+    auto check_node = [is_root](const auto& node) {
+        CHECK((is_root || node.size() >= (node.capacity() + 1) / 2 - 1));
+    };
+    if (t.get_model().is_leaf_id(id)) {
+        check_node(t.get_accessor().load_leaf(id));
+        return;
+    }
+    auto inode = t.get_accessor().load_inode(id);
+    check_node(inode);
+    for (std::size_t i = 0; i <= inode.size(); ++i) {
+        check_min_fill(t, inode.get_child(i), false);
+    }
+}
+
 } // namespace
 
 TEST_CASE("memory B+Tree: basic insert & find") {
@@ -296,3 +336,648 @@ TEST_CASE("memory B+Tree split on update") {
     t.dump();
 
 }
+
+TEST_CASE("memory B+Tree: bulk_load from sorted input") {
+    using Model = MemModel<int, std::string, 5>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+
+    for (int count : { 0, 1, 5, 6, 37, 1000 }) {
+        for (double fill : { 1.0, 0.6 }) {
+            Tree t;
+            std::vector<int> keys(static_cast<std::size_t>(count));
+            std::iota(keys.begin(), keys.end(), 0);
+            std::vector<std::string> values;
+            for (int k : keys) {
+                values.push_back(std::to_string(k));
+            }
+            std::vector<std::pair<key_like_type, value_in_type>> input;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                input.emplace_back(key_like_type{ keys[i] }, value_in_type{ values[i] });
+            }
+
+            REQUIRE(t.bulk_load(input, fill));
+
+            std::vector<int> tkeys;
+            for (auto& it : t) {
+                tkeys.push_back(it.first.get());
+            }
+            CHECK(tkeys == keys);
+
+            for (int k : keys) {
+                auto it = t.find(key_like_type{ k });
+                REQUIRE(it != t.end());
+                CHECK(it->second.get() == std::to_string(k));
+            }
+
+            // the tree stays fully functional after the build
+            std::map<int, std::string> ref;
+            for (int k : keys) {
+                ref[k] = std::to_string(k);
+            }
+            t.set_rebalance_policy(rebalance::neighbor_share);
+            std::mt19937 rng(static_cast<unsigned>(count));
+            std::uniform_int_distribution<int> keyd(0, count * 2 + 1);
+            for (int s = 0; s < 2000; ++s) {
+                int k = keyd(rng);
+                if (s % 3) {
+                    auto ts = std::to_string(k);
+                    ref[k] = ts;
+                    CHECK(t.insert(key_like_type{ k }, value_in_type{ ts }, insert::upsert));
+                }
+                else {
+                    CHECK(t.remove(key_like_type{ k }) == (ref.erase(k) > 0));
+                }
+            }
+            std::vector<int> rkeys;
+            for (auto& kv : ref) {
+                rkeys.push_back(kv.first);
+            }
+            tkeys.clear();
+            for (auto& it : t) {
+                tkeys.push_back(it.first.get());
+            }
+            CHECK(tkeys == rkeys);
+        }
+    }
+
+    Tree t;
+    std::string one = "1";
+    CHECK(t.insert(key_like_type{ 1 }, value_in_type{ one }));
+    std::vector<std::pair<key_like_type, value_in_type>> input;
+    CHECK_FALSE(t.bulk_load(input));
+}
+
+TEST_CASE("memory B+Tree: bulk_load evens out the right edge") {
+    using Model = MemModel<int, int, 5>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+
+    // counts that leave the last leaf as the only child of a fresh inode are included
+    for (int count = 1; count <= 200; ++count) {
+        for (double fill : { 1.0, 0.6 }) {
+            std::vector<int> values(static_cast<std::size_t>(count));
+            std::iota(values.begin(), values.end(), 0);
+            std::vector<std::pair<key_like_type, value_in_type>> input;
+            for (auto& v : values) {
+                input.emplace_back(key_like_type{ v }, value_in_type{ v });
+            }
+            Tree t;
+            REQUIRE(t.bulk_load(input, fill));
+            check_min_fill(t, std::get<0>(t.get_accessor().load_root()));
+            CHECK(static_cast<int>(t.layout().elements) == count);
+        }
+    }
+}
+
+TEST_CASE("memory B+Tree: insert_batch") {
+    using Model = CountedMemModel<int, std::string, 5>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+
+    Tree t;
+    t.set_rebalance_policy(rebalance::neighbor_share);
+    std::map<int, std::string> ref;
+    std::mt19937 rng(0xBA7C4);
+    std::uniform_int_distribution<int> keyd(0, 3000);
+
+    for (int round = 0; round < 20; ++round) {
+        std::vector<int> keys;
+        std::vector<std::string> values;
+        for (int i = 0; i < 200; ++i) {
+            keys.push_back(keyd(rng));
+            values.push_back(std::to_string(round) + ":" + std::to_string(keys.back()));
+        }
+        std::vector<std::pair<key_like_type, value_in_type>> batch;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            batch.emplace_back(key_like_type{ keys[i] }, value_in_type{ values[i] });
+        }
+
+        std::size_t expected = 0;
+        const auto ip = (round % 2) ? insert::upsert : insert::insert;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            const bool exists = ref.contains(keys[i]);
+            if (!exists || ip == insert::upsert) {
+                ref[keys[i]] = values[i];
+                ++expected;
+            }
+        }
+
+        CHECK(t.insert_batch(std::span{ batch }, ip) == expected);
+
+        std::vector<std::pair<int, std::string>> tree_items;
+        for (auto& it : t) {
+            tree_items.emplace_back(it.first.get(), it.second.get());
+        }
+        std::vector<std::pair<int, std::string>> ref_items(ref.begin(), ref.end());
+        REQUIRE(tree_items == ref_items);
+        auto [root, exists] = t.get_accessor().load_root();
+        REQUIRE(exists);
+        CHECK(check_child_counts(t, root) == ref.size());
+    }
+
+    for (auto& [k, v] : ref) {
+        auto it = t.find(key_like_type{ k });
+        REQUIRE(it != t.end());
+        CHECK(it->second.get() == v);
+    }
+}
+
+TEST_CASE("memory B+Tree: lower_bound, upper_bound, equal_range and range") {
+    using Model = MemModel<int, std::string, 4>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+    Tree t;
+
+    const int probe_lo = 0;
+    CHECK(t.lower_bound(key_like_type{ probe_lo }) == t.end());
+    CHECK(t.range(key_like_type{ probe_lo }, key_like_type{ probe_lo }).empty());
+
+    t.set_rebalance_policy(rebalance::neighbor_share);
+    for (int i = 0; i < 100; ++i) {
+        auto ts = std::to_string(i * 2);
+        CHECK(t.insert(key_like_type{ i * 2 }, value_in_type{ ts }, insert::insert));
+    }
+
+    for (int k = -1; k <= 200; ++k) {
+        const int expected_lower = (k < 0) ? 0 : (k + (k % 2));
+        const int expected_upper = (k < 0) ? 0 : (k + 1 + ((k + 1) % 2));
+
+        auto lower = t.lower_bound(key_like_type{ k });
+        auto upper = t.upper_bound(key_like_type{ k });
+        if (expected_lower >= 200) {
+            CHECK(lower == t.end());
+        }
+        else {
+            REQUIRE(lower != t.end());
+            CHECK(lower->first.get() == expected_lower);
+        }
+        if (expected_upper >= 200) {
+            CHECK(upper == t.end());
+        }
+        else {
+            REQUIRE(upper != t.end());
+            CHECK(upper->first.get() == expected_upper);
+        }
+
+        auto [first, last] = t.equal_range(key_like_type{ k });
+        CHECK(first == lower);
+        CHECK(last == upper);
+        CHECK(std::distance(first, last) == ((k >= 0 && k < 200 && k % 2 == 0) ? 1 : 0));
+    }
+
+    static_assert(std::ranges::bidirectional_range<decltype(t.range(std::declval<key_like_type>(), std::declval<key_like_type>()))>);
+
+    const int lo = 51;
+    const int hi = 80;
+    std::vector<int> keys;
+    for (auto& kv : t.range(key_like_type{ lo }, key_like_type{ hi })) {
+        keys.push_back(kv.first.get());
+    }
+    std::vector<int> expected;
+    for (int k = 52; k < 80; k += 2) {
+        expected.push_back(k);
+    }
+    CHECK(keys == expected);
+
+    auto reversed = t.range(key_like_type{ hi }, key_like_type{ lo });
+    CHECK(reversed.empty());
+    const int big = 1000;
+    CHECK(std::ranges::distance(t.range(key_like_type{ lo }, key_like_type{ big })) == 74);
+}
+
+TEST_CASE("memory B+Tree: cursor scans") {
+    using Model = MemModel<int, std::string, 4>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+    Tree t;
+
+    CHECK_FALSE(t.make_cursor().is_valid());
+    CHECK_FALSE(t.make_cursor_last().is_valid());
+
+    t.set_rebalance_policy(rebalance::neighbor_share);
+    for (int i = 0; i < 100; ++i) {
+        auto ts = std::to_string(i * 2);
+        CHECK(t.insert(key_like_type{ i * 2 }, value_in_type{ ts }, insert::insert));
+    }
+
+    std::vector<int> forward;
+    for (auto c = t.make_cursor(); c; c.next()) {
+        CHECK(c.value().get() == std::to_string(c.key().get()));
+        forward.push_back(c.key().get());
+    }
+    std::vector<int> expected;
+    for (auto& kv : t) {
+        expected.push_back(kv.first.get());
+    }
+    CHECK(forward == expected);
+
+    std::vector<int> backward;
+    for (auto c = t.make_cursor_last(); c; c.prev()) {
+        backward.push_back(c.key().get());
+    }
+    std::ranges::reverse(backward);
+    CHECK(backward == expected);
+
+    const int probe = 51;
+    auto c = t.make_cursor(key_like_type{ probe });
+    REQUIRE(c.is_valid());
+    CHECK(c.key().get() == 52);
+    CHECK(c.prev());
+    CHECK(c.key().get() == 50);
+
+    const int past = 198;
+    c = t.make_cursor(key_like_type{ past });
+    REQUIRE(c.is_valid());
+    CHECK_FALSE(c.next());
+    CHECK_FALSE(c.is_valid());
+
+    const int beyond = 1000;
+    CHECK_FALSE(t.make_cursor(key_like_type{ beyond }).is_valid());
+}
+
+TEST_CASE("memory B+Tree: descent path locates children in their parents") {
+    using Model = MemModel<int, std::string, 8>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+    Tree t;
+
+    std::vector<int> keys(2000);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::mt19937 rng(0xD35C);
+    std::ranges::shuffle(keys, rng);
+    for (int k : keys) {
+        auto ts = std::to_string(k);
+        CHECK(t.insert(key_like_type{ k }, value_in_type{ ts }));
+    }
+
+    for (int k = 0; k < 2000; k += 7) {
+        auto [leaf_id, pos, found] = t.find_node_with(key_like_type{ k });
+        REQUIRE(found);
+        const auto path = t.descent_path_;
+        REQUIRE(path.size() > 1);
+        for (std::size_t i = 0; i < path.size(); ++i) {
+            const auto child = (i + 1 < path.size()) ? path[i + 1].node : leaf_id;
+            auto parent = t.get_accessor().load_inode(path[i].node);
+            CHECK(parent.get_child(path[i].pos) == child);
+            CHECK(t.find_child_index_in_parent(parent, child) == path[i].pos);
+        }
+    }
+
+    // removals rebalance through the hinted lookup; the result must match std::map
+    std::map<int, std::string> ref;
+    for (int k = 0; k < 2000; ++k) {
+        ref[k] = std::to_string(k);
+    }
+    for (std::size_t i = 0; i < keys.size(); i += 2) {
+        CHECK(t.remove(key_like_type{ keys[i] }));
+        ref.erase(keys[i]);
+    }
+    std::vector<int> tkeys;
+    for (auto& kv : t) {
+        tkeys.push_back(kv.first.get());
+    }
+    std::vector<int> rkeys;
+    for (auto& kv : ref) {
+        rkeys.push_back(kv.first);
+    }
+    CHECK(tkeys == rkeys);
+}
+
+TEST_CASE("memory B+Tree: rank, nth, count and iterator jumps") {
+    using Model = CountedMemModel<int, std::string, 5>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+    static_assert(Tree::has_child_counts);
+
+    Tree t;
+    std::vector<int> ref;
+    auto check_all = [&]() {
+        auto [root, exists] = t.get_accessor().load_root();
+        if (exists) {
+            CHECK(check_child_counts(t, root) == ref.size());
+        }
+        for (std::size_t i = 0; i < ref.size(); i += 3) {
+            auto it = t.nth(i);
+            REQUIRE(it != t.end());
+            CHECK(it->first.get() == ref[i]);
+            CHECK(t.rank(key_like_type{ ref[i] }) == i);
+            CHECK((t.begin() + static_cast<std::ptrdiff_t>(i)) == it);
+        }
+        CHECK(t.nth(ref.size()) == t.end());
+        if (!ref.empty()) {
+            auto last = t.end() + (-1);
+            REQUIRE(last != t.end());
+            CHECK(last->first.get() == ref.back());
+            CHECK((last + (-static_cast<std::ptrdiff_t>(ref.size() - 1))) == t.begin());
+        }
+        for (int lo = -5; lo < 2100; lo += 97) {
+            const int hi = lo + 250;
+            const auto expected = std::ranges::lower_bound(ref, hi) - std::ranges::lower_bound(ref, lo);
+            CHECK(t.count(key_like_type{ lo }, key_like_type{ hi }) == static_cast<std::size_t>(expected));
+            CHECK(t.rank(key_like_type{ lo }) == static_cast<std::size_t>(std::ranges::lower_bound(ref, lo) - ref.begin()));
+        }
+        CHECK(t.count(key_like_type{ 10 }, key_like_type{ 10 }) == 0);
+    };
+
+    std::mt19937 rng(0x0571);
+    std::vector<int> keys(2000);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::ranges::shuffle(keys, rng);
+    for (int k : keys) {
+        auto ts = std::to_string(k);
+        REQUIRE(t.insert(key_like_type{ k }, value_in_type{ ts }));
+    }
+    ref = keys;
+    std::ranges::sort(ref);
+    check_all();
+
+    // removals merge and borrow, upserts leave the counts alone
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (i % 3 != 0) {
+            REQUIRE(t.remove(key_like_type{ keys[i] }));
+            std::erase(ref, keys[i]);
+        }
+        else if (i % 5 == 0) {
+            auto ts = std::string("v");
+            CHECK(t.insert(key_like_type{ keys[i] }, value_in_type{ ts }, insert::upsert));
+        }
+    }
+    check_all();
+
+    // the iterator jumps across leaves in both directions
+    auto it = t.begin();
+    std::size_t at = 0;
+    for (std::ptrdiff_t step : { 17, 5, -9, 120, -3, 1, -100, 250 }) {
+        it += step;
+        at = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(at) + step);
+        REQUIRE(it != t.end());
+        CHECK(it->first.get() == ref[at]);
+    }
+
+    Tree bulk;
+    std::vector<std::string> values;
+    for (int k : ref) {
+        values.push_back(std::to_string(k));
+    }
+    std::vector<std::pair<key_like_type, value_in_type>> input;
+    for (std::size_t i = 0; i < ref.size(); ++i) {
+        input.emplace_back(key_like_type{ ref[i] }, value_in_type{ values[i] });
+    }
+    REQUIRE(bulk.bulk_load(input, 0.7));
+    auto [root, exists] = bulk.get_accessor().load_root();
+    REQUIRE(exists);
+    CHECK(check_child_counts(bulk, root) == ref.size());
+    CHECK(bulk.nth(ref.size() / 2)->first.get() == ref[ref.size() / 2]);
+
+    while (!ref.empty()) {
+        REQUIRE(t.remove(key_like_type{ ref.back() }));
+        ref.pop_back();
+        if (ref.size() % 97 == 0) {
+            check_all();
+        }
+    }
+}
+
+TEST_CASE("memory B+Tree: compact merges sparse leaves") {
+    using Model = CountedMemModel<int, std::string, 6>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+
+    Tree t;
+    Tree empty;
+    auto nothing = empty.compact();
+    REQUIRE(nothing);
+    CHECK(nothing->after.leaves == 0);
+
+    std::map<int, std::string> ref;
+    for (int k = 0; k < 3000; ++k) {
+        ref[k] = std::to_string(k);
+        auto ts = ref[k];
+        REQUIRE(t.insert(key_like_type{ k }, value_in_type{ ts }));
+    }
+    for (int k = 0; k < 3000; ++k) {
+        if (k % 5 != 0) {
+            REQUIRE(t.remove(key_like_type{ k }));
+            ref.erase(k);
+        }
+    }
+
+    const auto report = t.compact();
+    REQUIRE(report);
+    CHECK(report->before.elements == ref.size());
+    CHECK(report->after.elements == ref.size());
+    CHECK(report->after.leaves == (ref.size() + 5) / 6);
+    CHECK(report->after.fill > report->before.fill);
+
+    auto [root, exists] = t.get_accessor().load_root();
+    REQUIRE(exists);
+    CHECK(check_child_counts(t, root) == ref.size());
+    auto it = t.begin();
+    for (auto& [k, v] : ref) {
+        REQUIRE(it != t.end());
+        CHECK(it->first.get() == k);
+        CHECK(it->second.get() == v);
+        ++it;
+    }
+    CHECK(it == t.end());
+
+    for (int k = 1; k < 3000; k += 5) {
+        ref[k] = "new";
+        auto ts = ref[k];
+        REQUIRE(t.insert(key_like_type{ k }, value_in_type{ ts }));
+    }
+    for (int k = 0; k < 3000; k += 10) {
+        REQUIRE(t.remove(key_like_type{ k }));
+        ref.erase(k);
+    }
+    CHECK(t.layout().elements == ref.size());
+    CHECK(t.rank(key_like_type{ 1500 }) == static_cast<std::size_t>(std::distance(ref.begin(), ref.lower_bound(1500))));
+}
+
+TEST_CASE("memory B+Tree: append mode keeps ascending inserts in full leaves") {
+    using Model = CountedMemModel<int, std::string, 8>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+
+    Tree plain;
+    plain.set_rebalance_policy(rebalance::force_split);
+    Tree appended;
+    appended.set_rebalance_policy(rebalance::force_split);
+    appended.set_append_mode(true);
+    for (int k = 0; k < 4000; ++k) {
+        auto a = std::to_string(k);
+        auto b = a;
+        REQUIRE(plain.insert(key_like_type{ k }, value_in_type{ a }));
+        REQUIRE(appended.insert(key_like_type{ k }, value_in_type{ b }));
+    }
+    CHECK(plain.layout().fill < 0.6);
+    const auto stats = appended.layout();
+    CHECK(stats.leaves == 500);
+    CHECK(stats.fill == doctest::Approx(1.0));
+
+    // keys below the maximum, duplicates and removals still work in append mode
+    std::map<int, std::string> ref;
+    for (int k = 0; k < 4000; ++k) {
+        ref[k] = std::to_string(k);
+    }
+    for (int k = 1; k < 4000; k += 10) {
+        REQUIRE(appended.remove(key_like_type{ k }));
+        ref.erase(k);
+    }
+    for (int k = 4000; k < 5000; ++k) {
+        ref[k * 2] = std::to_string(k);
+        auto v = ref[k * 2];
+        REQUIRE(appended.insert(key_like_type{ k * 2 }, value_in_type{ v }));
+        if (k % 7 == 0) {
+            ref[k] = "gap";
+            auto g = ref[k];
+            REQUIRE(appended.insert(key_like_type{ k }, value_in_type{ g }));
+        }
+        auto dup = std::string("dup");
+        CHECK_FALSE(appended.insert(key_like_type{ k * 2 }, value_in_type{ dup }));
+    }
+    for (int k = 9999; k > 9000; k -= 3) {
+        if (ref.erase(k - 1) > 0) {
+            REQUIRE(appended.remove(key_like_type{ k - 1 }));
+        }
+    }
+    for (int k = 10000; k < 10100; ++k) {
+        ref[k] = std::to_string(k);
+        auto v = ref[k];
+        REQUIRE(appended.insert(key_like_type{ k }, value_in_type{ v }));
+    }
+
+    auto it = appended.begin();
+    for (auto& [k, v] : ref) {
+        REQUIRE(it != appended.end());
+        CHECK(it->first.get() == k);
+        CHECK(it->second.get() == v);
+        ++it;
+    }
+    CHECK(it == appended.end());
+    auto [root, exists] = appended.get_accessor().load_root();
+    REQUIRE(exists);
+    CHECK(check_child_counts(appended, root) == ref.size());
+}
+
+TEST_CASE("memory B+Tree: find_many matches find") {
+    using Model = MemModel<int, std::string, 5>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+
+    Tree t;
+    CHECK(t.find_many(std::vector<key_like_type>{ key_like_type{ 1 } }).front() == t.end());
+    for (int k = 0; k < 3000; k += 3) {
+        auto v = std::to_string(k);
+        REQUIRE(t.insert(key_like_type{ k }, value_in_type{ v }));
+    }
+
+    // key_like_type points at its key; the keys have to outlive the probes
+    std::mt19937 rng(0xF1AD);
+    std::vector<int> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(static_cast<int>(rng() % 3100) - 50);
+    }
+    keys.push_back(9);
+    keys.push_back(9);
+    std::vector<key_like_type> probes;
+    for (const auto& k : keys) {
+        probes.emplace_back(k);
+    }
+    const auto found = t.find_many(probes);
+    REQUIRE(found.size() == probes.size());
+    for (std::size_t i = 0; i < probes.size(); ++i) {
+        CHECK(found[i] == t.find(probes[i]));
+        if (found[i] != t.end()) {
+            CHECK(found[i]->first.get() == probes[i].get());
+        }
+    }
+    CHECK(t.find_many({}).empty());
+}
+
+TEST_CASE("memory B+Tree: erase_range matches std::map") {
+    using Model = CountedMemModel<int, std::string, 5>;
+    using Tree = fulla::bpt::tree<Model>;
+    using key_like_type = typename Model::key_like_type;
+    using value_in_type = typename Model::value_in_type;
+
+    Tree t;
+    std::map<int, std::string> ref;
+    const auto fill = [&](int from, int to) {
+        for (int k = from; k < to; ++k) {
+            if (!ref.contains(k * 2)) {
+                ref[k * 2] = std::to_string(k);
+                auto v = ref[k * 2];
+                REQUIRE(t.insert(key_like_type{ k * 2 }, value_in_type{ v }));
+            }
+        }
+    };
+    const auto check_same = [&]() {
+        auto it = t.begin();
+        for (auto& [k, v] : ref) {
+            REQUIRE(it != t.end());
+            CHECK(it->first.get() == k);
+            CHECK(it->second.get() == v);
+            ++it;
+        }
+        CHECK(it == t.end());
+        // the prev links of the leaves survive as well
+        auto back = t.end();
+        for (auto r = ref.rbegin(); r != ref.rend(); ++r) {
+            --back;
+            REQUIRE(back->first.get() == r->first);
+        }
+        auto [root, exists] = t.get_accessor().load_root();
+        CHECK(exists == !ref.empty());
+        if (exists) {
+            CHECK(check_child_counts(t, root) == ref.size());
+            check_min_fill(t, root);
+        }
+    };
+
+    fill(0, 3000);
+    CHECK(t.erase_range(key_like_type{ 100 }, key_like_type{ 100 }) == 0);
+    CHECK(t.erase_range(key_like_type{ 101 }, key_like_type{ 102 }) == 0);
+    CHECK(t.erase_range(key_like_type{ 200 }, key_like_type{ 100 }) == 0);
+    check_same();
+
+    std::mt19937 rng(0xE2A5);
+    for (int round = 0; round < 300; ++round) {
+        const int lo = static_cast<int>(rng() % 6200) - 100;
+        const int hi = lo + static_cast<int>(rng() % (round % 3 == 0 ? 2000 : 40));
+        const auto first = ref.lower_bound(lo);
+        const auto last = (lo < hi) ? ref.lower_bound(hi) : first;
+        const auto expected = static_cast<std::size_t>(std::distance(first, last));
+        ref.erase(first, last);
+        REQUIRE(t.erase_range(key_like_type{ lo }, key_like_type{ hi }) == expected);
+        check_same();
+        if (ref.size() < 500) {
+            fill(static_cast<int>(rng() % 2000), 3000);
+        }
+    }
+
+    // the leftmost part, the rightmost part and then everything
+    ref.erase(ref.begin(), ref.lower_bound(1000));
+    t.erase_range(key_like_type{ -1 }, key_like_type{ 1000 });
+    check_same();
+    ref.erase(ref.lower_bound(5000), ref.end());
+    t.erase_range(key_like_type{ 5000 }, key_like_type{ 7000 });
+    check_same();
+    const auto left = ref.size();
+    CHECK(t.erase_range(key_like_type{ -1 }, key_like_type{ 7000 }) == left);
+    ref.clear();
+    check_same();
+    fill(0, 100);
+    check_same();
+}
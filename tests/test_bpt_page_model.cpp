@@ -1,6 +1,8 @@
 #include <filesystem>
+#include <functional>
 #include <vector>
 #include <map>
+#include <set>
 
 #include "tests.hpp"
 
@@ -291,4 +293,1439 @@ TEST_SUITE("bpt/paged/model bpt") {
 		}
 
 	}
+
+	TEST_CASE("bulk load") {
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		BM bm(mem, 16);
+
+		std::map<std::string, std::string> test;
+		while (test.size() < 5000) {
+			auto ts = get_random_string(5, 40);
+			test[ts] = ts + "_value";
+		}
+
+		std::vector<byte_buffer> keys;
+		keys.reserve(test.size());
+		std::vector<std::pair<key_like_type, value_in_type>> input;
+		for (auto& [k, v] : test) {
+			auto rec = prop::make_record(prop::str{ k });
+			keys.emplace_back(rec.view().begin(), rec.view().end());
+		}
+		std::size_t id = 0;
+		for (auto& [k, v] : test) {
+			input.emplace_back(key_like_type{ keys[id++] }, as_value_in(v));
+		}
+
+		for (double fill : { 1.0, 0.7 }) {
+			memory_block_device tree_mem(DEFAULT_BUFFER_SIZE);
+			BM tree_bm(tree_mem, 16);
+			bpt_type bpt(tree_bm);
+			REQUIRE(bpt.bulk_load(input, fill));
+			validate_keys(bpt);
+
+			std::size_t count = 0;
+			auto it = bpt.begin();
+			for (auto& [k, v] : test) {
+				REQUIRE(it != bpt.end());
+				CHECK(as_string(it->second) == v);
+				++it;
+				++count;
+			}
+			CHECK(it == bpt.end());
+			CHECK(count == test.size());
+
+			for (auto& [k, v] : test) {
+				auto key = prop::make_record(prop::str{ k });
+				auto found = bpt.find(key_like_type{ key.view() });
+				REQUIRE(found != bpt.end());
+				CHECK(as_string(found->second) == v);
+			}
+
+			// inserts and removals keep working on a bulk-loaded tree
+			auto copy = test;
+			for (int i = 0; i < 500; ++i) {
+				auto ts = get_random_string(5, 40);
+				auto key = prop::make_record(prop::str{ ts });
+				if (!copy.contains(ts)) {
+					REQUIRE(bpt.insert(key_like_type{ key.view() }, as_value_in(ts)));
+					copy[ts] = ts;
+				}
+			}
+			while (copy.size() > 100) {
+				auto key = prop::make_record(prop::str{ copy.begin()->first });
+				REQUIRE(bpt.remove(key_like_type{ key.view() }));
+				copy.erase(copy.begin());
+			}
+			validate_keys(bpt);
+			for (auto& [k, v] : copy) {
+				auto key = prop::make_record(prop::str{ k });
+				CHECK(bpt.find(key_like_type{ key.view() }) != bpt.end());
+			}
+		}
+	}
+
+	TEST_CASE("insert batch") {
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		BM bm(mem, 16);
+		bpt_type bpt(bm);
+		bpt.set_rebalance_policy(fulla::bpt::policies::rebalance::neighbor_share);
+
+		std::map<std::string, std::string> test;
+		for (int round = 0; round < 10; ++round) {
+			std::vector<std::string> words;
+			for (int i = 0; i < 500; ++i) {
+				words.push_back(get_random_string(5, 40));
+			}
+			std::vector<byte_buffer> keys;
+			for (auto& w : words) {
+				auto rec = prop::make_record(prop::str{ w });
+				keys.emplace_back(rec.view().begin(), rec.view().end());
+			}
+			std::vector<std::pair<key_like_type, value_in_type>> batch;
+			std::size_t expected = 0;
+			for (std::size_t i = 0; i < words.size(); ++i) {
+				batch.emplace_back(key_like_type{ keys[i] }, as_value_in(words[i]));
+				if (test.emplace(words[i], words[i]).second) {
+					++expected;
+				}
+			}
+			CHECK(bpt.insert_batch(std::span{ batch }) == expected);
+			validate_keys(bpt);
+		}
+
+		std::size_t count = 0;
+		auto it = bpt.begin();
+		for (auto& [k, v] : test) {
+			REQUIRE(it != bpt.end());
+			CHECK(as_string(it->second) == v);
+			++it;
+			++count;
+		}
+		CHECK(it == bpt.end());
+		CHECK(count == test.size());
+	}
+
+	TEST_CASE("lower bound and prefix range") {
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		BM bm(mem, 16);
+		bpt_type bpt(bm);
+		bpt.set_rebalance_policy(fulla::bpt::policies::rebalance::neighbor_share);
+
+		std::set<std::string> test;
+		while (test.size() < 3000) {
+			auto ts = get_random_string(3, 30);
+			test.insert(ts);
+			auto key = prop::make_record(prop::str{ ts });
+			bpt.insert(key_like_type{ key.view() }, as_value_in(ts));
+		}
+
+		for (int i = 0; i < 200; ++i) {
+			const auto probe = get_random_string(1, 30);
+			const auto key = prop::make_record(prop::str{ probe });
+			auto lower = bpt.lower_bound(key_like_type{ key.view() });
+			auto upper = bpt.upper_bound(key_like_type{ key.view() });
+			auto ref_lower = test.lower_bound(probe);
+			auto ref_upper = test.upper_bound(probe);
+			if (ref_lower == test.end()) {
+				CHECK(lower == bpt.end());
+			}
+			else {
+				REQUIRE(lower != bpt.end());
+				CHECK(as_string(lower->second) == *ref_lower);
+			}
+			if (ref_upper == test.end()) {
+				CHECK(upper == bpt.end());
+			}
+			else {
+				REQUIRE(upper != bpt.end());
+				CHECK(as_string(upper->second) == *ref_upper);
+			}
+		}
+
+		// prefix query: [prefix, prefix + 0xFF)
+		for (int i = 0; i < 50; ++i) {
+			const auto prefix = get_random_string(1, 2);
+			const auto lo = prop::make_record(prop::str{ prefix });
+			const auto hi = prop::make_record(prop::str{ prefix + "\xff" });
+			std::vector<std::string> found;
+			for (auto& kv : bpt.range(key_like_type{ lo.view() }, key_like_type{ hi.view() })) {
+				found.push_back(std::string(as_string(kv.second)));
+			}
+			std::vector<std::string> expected;
+			for (auto it = test.lower_bound(prefix); it != test.end() && it->starts_with(prefix); ++it) {
+				expected.push_back(*it);
+			}
+			CHECK(found == expected);
+		}
+	}
+
+	TEST_CASE("cursor keeps the leaf pinned") {
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		BM bm(mem, 16);
+		bpt_type bpt(bm);
+		bpt.set_rebalance_policy(fulla::bpt::policies::rebalance::neighbor_share);
+
+		std::map<std::string, std::string> test;
+		while (test.size() < 3000) {
+			auto ts = get_random_string(5, 40);
+			test[ts] = ts;
+			auto key = prop::make_record(prop::str{ ts });
+			bpt.insert(key_like_type{ key.view() }, as_value_in(ts));
+		}
+
+		std::vector<std::string> forward;
+		std::size_t leaves = 0;
+		auto last_node = bpt.get_invalid_id();
+		for (auto c = bpt.make_cursor(); c; c.next()) {
+			if (c.node_id() != last_node) {
+				last_node = c.node_id();
+				++leaves;
+			}
+			forward.emplace_back(as_string(c.value()));
+		}
+		std::vector<std::string> expected;
+		for (auto& [k, v] : test) {
+			expected.push_back(v);
+		}
+		CHECK(forward == expected);
+		CHECK(leaves > 1);
+
+		std::vector<std::string> backward;
+		for (auto c = bpt.make_cursor_last(); c; c.prev()) {
+			backward.emplace_back(as_string(c.value()));
+		}
+		std::ranges::reverse(backward);
+		CHECK(backward == expected);
+
+		auto probe = test.begin();
+		std::advance(probe, 1000);
+		const auto key = prop::make_record(prop::str{ probe->first });
+		auto c = bpt.make_cursor(key_like_type{ key.view() });
+		REQUIRE(c.is_valid());
+		CHECK(as_string(c.value()) == probe->second);
+	}
+
+	TEST_CASE("model without parent links") {
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		using BM = buffer_manager<memory_block_device>;
+		using root_manager_type = paged::memory_root_manager<typename BM::pid_type>;
+		using model_type = paged::model<BM, fulla::page::record_less, root_manager_type, paged::parentless_bpt_descriptor>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		static_assert(!bpt_type::has_parent_links);
+
+		BM bm(mem, 32);
+		bpt_type bpt(bm);
+
+		std::map<std::string, std::string> test;
+		while (test.size() < 4000) {
+			auto ts = get_random_string(20, 90);
+			auto key = prop::make_record(prop::str{ ts });
+			CHECK(bpt.insert(key_like_type{ key.view() }, as_value_in(ts)) == test.emplace(ts, ts).second);
+		}
+
+		const auto check_tree = [&](bpt_type& t) {
+			validate_keys(t);
+			std::vector<std::string> found;
+			for (auto c = t.make_cursor(); c; c.next()) {
+				auto leaf = t.get_accessor().load_leaf(c.node_id());
+				CHECK(leaf.get_page().subheader<fulla::page::bpt_leaf_header>()->parent == model_type::invalid_node_value);
+				found.emplace_back(as_string(c.value()));
+			}
+			std::vector<std::string> expected;
+			for (auto& [k, v] : test) {
+				expected.push_back(v);
+			}
+			CHECK(found == expected);
+		};
+		check_tree(bpt);
+
+		// an operation only keeps the links it used, and lookups leave them alone
+		const auto known = bpt.parent_ids_.size();
+		CHECK(known < 64);
+		for (auto& [k, v] : test) {
+			auto key = prop::make_record(prop::str{ k });
+			CHECK(bpt.find(key_like_type{ key.view() }) != bpt.end());
+			CHECK(bpt.lower_bound(key_like_type{ key.view() }) != bpt.end());
+		}
+		CHECK(bpt.parent_ids_.size() == known);
+
+		// a second tree over the same pages starts without any known parent links
+		root_manager_type root;
+		root.set_root(std::get<0>(bpt.get_accessor().load_root()));
+		bpt_type reopened(bm, root);
+
+		std::vector<std::string> keys;
+		for (auto& [k, v] : test) {
+			keys.push_back(k);
+		}
+		std::mt19937 rng(0x9A4E);
+		std::ranges::shuffle(keys, rng);
+		for (std::size_t i = 0; i < keys.size(); i += 2) {
+			auto key = prop::make_record(prop::str{ keys[i] });
+			CHECK(reopened.remove(key_like_type{ key.view() }));
+			test.erase(keys[i]);
+		}
+		for (int i = 0; i < 1000; ++i) {
+			auto ts = get_random_string(20, 90);
+			auto key = prop::make_record(prop::str{ ts });
+			CHECK(reopened.insert(key_like_type{ key.view() }, as_value_in(ts)) == test.emplace(ts, ts).second);
+		}
+		check_tree(reopened);
+		CHECK(reopened.parent_ids_.size() < 64);
+	}
+
+	TEST_CASE("bytewise keys with shared prefixes") {
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		BM bm(mem, 32);
+		bpt_type bpt(bm);
+
+		const std::vector<std::string> dirs = {
+			"/usr/local/share/applications/", "/usr/local/share/icons/hicolor/",
+			"/usr/lib/", "/var/log/", "/home/user/projects/fulladb/",
+		};
+		std::set<std::string> test;
+		for (int i = 0; i < 4000; ++i) {
+			auto path = dirs[i % dirs.size()] + get_random_string(1, 30);
+			const bool inserted = test.insert(path).second;
+			CHECK(bpt.insert(as_key_like(path), as_value_in(path)) == inserted);
+		}
+
+		std::vector<std::string> found;
+		for (auto& kv : bpt) {
+			found.emplace_back(as_string(kv.second));
+		}
+		CHECK(std::ranges::equal(found, test));
+
+		std::vector<std::string> probes = { "", "/", "/usr", "/usr/local/share/", "/usr/local/share/icons/hicolor/z", "/zzz", "/home/user/projects/fulladb/" };
+		for (int i = 0; i < 300; ++i) {
+			probes.push_back(dirs[i % dirs.size()] + get_random_string(0, 30));
+		}
+		for (auto& probe : probes) {
+			auto lower = bpt.lower_bound(as_key_like(probe));
+			auto upper = bpt.upper_bound(as_key_like(probe));
+			auto ref_lower = test.lower_bound(probe);
+			auto ref_upper = test.upper_bound(probe);
+			if (ref_lower == test.end()) {
+				CHECK(lower == bpt.end());
+			}
+			else {
+				REQUIRE(lower != bpt.end());
+				CHECK(as_string(lower->second) == *ref_lower);
+			}
+			if (ref_upper == test.end()) {
+				CHECK(upper == bpt.end());
+			}
+			else {
+				REQUIRE(upper != bpt.end());
+				CHECK(as_string(upper->second) == *ref_upper);
+			}
+		}
+
+		for (auto& path : test) {
+			CHECK(bpt.find(as_key_like(path)) != bpt.end());
+		}
+	}
+
+	TEST_CASE("prefix-compressed keys") {
+		using BM = buffer_manager<memory_block_device>;
+		using root_manager_type = paged::memory_root_manager<typename BM::pid_type>;
+		using plain_model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less, root_manager_type, paged::prefix_bpt_descriptor>;
+		using plain_bpt_type = fulla::bpt::tree<plain_model_type>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		static_assert(model_type::prefix_keys);
+
+		const std::vector<std::string> dirs = {
+			"/usr/local/share/applications/", "/usr/local/share/icons/hicolor/scalable/apps/",
+			"/usr/lib/", "/home/user/projects/fulladb/include/fulla/",
+		};
+		memory_block_device plain_mem(DEFAULT_BUFFER_SIZE);
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM plain_bm(plain_mem, 32);
+		BM bm(mem, 32);
+		plain_bpt_type plain(plain_bm);
+		bpt_type bpt(bm);
+
+		const std::string value = "v";
+		std::set<std::string> test;
+		for (int i = 0; i < 6000; ++i) {
+			auto path = dirs[i % dirs.size()] + get_random_string(1, 12);
+			const bool inserted = test.insert(path).second;
+			CHECK(plain.insert(as_key_like(path), as_value_in(value)) == inserted);
+			CHECK(bpt.insert(as_key_like(path), as_value_in(value)) == inserted);
+		}
+		// the pages keep the rest of the keys only
+		CHECK(bpt.layout().leaves * 3 < plain.layout().leaves * 2);
+
+		const auto key_string = [](const auto& kout) {
+			return std::string(reinterpret_cast<const char*>(kout.key.data()), kout.key.size());
+		};
+		const auto check_tree = [&]() {
+			std::vector<std::string> keys;
+			for (auto& kv : bpt) {
+				keys.emplace_back(key_string(kv.first));
+			}
+			CHECK(std::ranges::equal(keys, test));
+
+			std::vector<std::string> probes = { "", "/", "/usr", "/usr/lib", "/usr/lib/", "/usr/local/share/icons/", "/zzz" };
+			for (int i = 0; i < 300; ++i) {
+				probes.push_back(dirs[i % dirs.size()] + get_random_string(0, 12));
+				probes.push_back(dirs[i % dirs.size()].substr(0, static_cast<std::size_t>(i) % dirs[i % dirs.size()].size()));
+			}
+			for (auto& probe : probes) {
+				auto lower = bpt.lower_bound(as_key_like(probe));
+				auto upper = bpt.upper_bound(as_key_like(probe));
+				auto ref_lower = test.lower_bound(probe);
+				auto ref_upper = test.upper_bound(probe);
+				if (ref_lower == test.end()) {
+					CHECK(lower == bpt.end());
+				}
+				else {
+					REQUIRE(lower != bpt.end());
+					CHECK(key_string(lower->first) == *ref_lower);
+				}
+				if (ref_upper == test.end()) {
+					CHECK(upper == bpt.end());
+				}
+				else {
+					REQUIRE(upper != bpt.end());
+					CHECK(key_string(upper->first) == *ref_upper);
+				}
+			}
+			for (auto& key : test) {
+				CHECK(bpt.find(as_key_like(key)) != bpt.end());
+			}
+		};
+		check_tree();
+
+		// merges and borrows store the moved keys against the prefix of their new page
+		std::vector<std::string> keys(test.begin(), test.end());
+		std::mt19937 rng(0x9F1C);
+		std::ranges::shuffle(keys, rng);
+		for (std::size_t i = 0; i < keys.size(); ++i) {
+			if (i % 4 != 0) {
+				CHECK(bpt.remove(as_key_like(keys[i])));
+				test.erase(keys[i]);
+			}
+		}
+		check_tree();
+
+		memory_block_device bulk_mem(DEFAULT_BUFFER_SIZE);
+		BM bulk_bm(bulk_mem, 32);
+		bpt_type bulk(bulk_bm);
+		std::vector<std::pair<key_like_type, value_in_type>> input;
+		for (auto& key : test) {
+			input.emplace_back(as_key_like(key), as_value_in(value));
+		}
+		REQUIRE(bulk.bulk_load(input, 1.0));
+		std::vector<std::string> loaded;
+		for (auto& kv : bulk) {
+			loaded.emplace_back(key_string(kv.first));
+		}
+		CHECK(std::ranges::equal(loaded, test));
+	}
+
+	TEST_CASE("truncated separators") {
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		static_assert(fulla::bpt::concepts::ModelSeparator<model_type>);
+		static_assert(!fulla::bpt::concepts::ModelSeparator<paged::model<BM>>);
+
+		const auto left = std::string("/var/log/apache");
+		const auto right = std::string("/var/log/nginx/access");
+		auto sep = model_type::make_separator(as_key_like(left), as_key_like(right));
+		CHECK(std::string(reinterpret_cast<const char*>(sep.key.data()), sep.key.size()) == "/var/log/n");
+		const auto shorter = std::string("/var/log");
+		sep = model_type::make_separator(as_key_like(shorter), as_key_like(right));
+		CHECK(std::string(reinterpret_cast<const char*>(sep.key.data()), sep.key.size()) == "/var/log/");
+
+		BM bm(mem, 32);
+		bpt_type bpt(bm);
+
+		std::set<std::string> test;
+		const auto prefix = std::string(60, 'p');
+		for (int i = 0; i < 4000; ++i) {
+			auto key = prefix + get_random_string(1, 20);
+			const bool inserted = test.insert(key).second;
+			CHECK(bpt.insert(as_key_like(key), as_value_in(key)) == inserted);
+		}
+
+		// separators are mostly truncated right after the first distinguishing byte;
+		// full keys average prefix + 10 bytes
+		std::set<typename model_type::node_id_type> parents;
+		for (auto c = bpt.make_cursor(); c; c.next()) {
+			auto leaf = bpt.get_accessor().load_leaf(c.node_id());
+			parents.insert(leaf.get_parent());
+		}
+		std::size_t total = 0;
+		std::size_t count = 0;
+		for (auto id : parents) {
+			auto inode = bpt.get_accessor().load_inode(id);
+			REQUIRE(inode.is_valid());
+			for (std::size_t i = 0; i < inode.size(); ++i) {
+				total += inode.get_key(i).key.size();
+				++count;
+			}
+		}
+		REQUIRE(count > 0);
+		CHECK(total / count < prefix.size() + 6);
+
+		std::vector<std::string> keys(test.begin(), test.end());
+		std::mt19937 rng(0x5E9A);
+		std::ranges::shuffle(keys, rng);
+		for (std::size_t i = 0; i < keys.size(); i += 2) {
+			CHECK(bpt.remove(as_key_like(keys[i])));
+			test.erase(keys[i]);
+		}
+		for (int i = 0; i < 2000; ++i) {
+			auto key = prefix + get_random_string(1, 20);
+			const bool inserted = test.insert(key).second;
+			CHECK(bpt.insert(as_key_like(key), as_value_in(key)) == inserted);
+		}
+
+		std::vector<std::string> found;
+		for (auto& kv : bpt) {
+			found.emplace_back(as_string(kv.second));
+		}
+		CHECK(std::ranges::equal(found, test));
+		for (auto& key : test) {
+			CHECK(bpt.find(as_key_like(key)) != bpt.end());
+		}
+	}
+
+	TEST_CASE("order-preserving keys") {
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+
+		BM bm(mem, 16);
+		bpt_type bpt(bm);
+
+		// (i32, string) keys: memcmp over the encoding must order them as the typed tuples
+		std::mt19937 rng(0x0DE2);
+		std::uniform_int_distribution<std::int32_t> ids(-500, 500);
+		std::vector<prop::rec> typed;
+		for (int i = 0; i < 2000; ++i) {
+			const auto id = ids(rng);
+			const auto name = get_random_string(0, 8);
+			auto key = prop::make_ordered_record(prop::i32{ id }, prop::str{ name });
+			if (bpt.insert(key_like_type{ key.view() }, as_value_in(std::to_string(typed.size())))) {
+				typed.emplace_back(prop::make_record(prop::i32{ id }, prop::str{ name }));
+			}
+		}
+
+		std::vector<std::size_t> order;
+		for (auto& kv : bpt) {
+			order.emplace_back(std::stoul(as_string(kv.second)));
+		}
+		REQUIRE(order.size() == typed.size());
+		for (std::size_t i = 1; i < order.size(); ++i) {
+			CHECK(std::is_lt(data_view::compare_sequence(typed[order[i - 1]].view(), typed[order[i]].view())));
+		}
+	}
+
+	TEST_CASE("node search heads") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+
+		// many keys share their first bytes past the page prefix, so the heads tie often
+		const std::vector<std::string> dirs = {
+			"/usr/local/share/applications/", "/usr/local/share/icons/", "/usr/lib/", "/usr/libexec/", "/var/log/",
+		};
+		// 16 heads overflow on most nodes and fall back to the plain search
+		for (std::size_t heads : { 0, 16, 256 }) {
+			memory_block_device mem(DEFAULT_BUFFER_SIZE);
+			BM bm(mem, 32);
+			paged::settings sett;
+			sett.inode_search_heads = heads;
+			sett.leaf_search_heads = heads;
+			bpt_type bpt(bm, sett);
+
+			std::set<std::string> test;
+			for (int i = 0; i < 6000; ++i) {
+				auto path = dirs[i % dirs.size()] + get_random_string(1, 12);
+				const bool inserted = test.insert(path).second;
+				CHECK(bpt.insert(as_key_like(path), as_value_in(path)) == inserted);
+			}
+
+			std::size_t indexed = 0;
+			std::size_t leafs = 0;
+			std::size_t indexed_leafs = 0;
+			std::set<typename model_type::node_id_type> parents;
+			for (auto c = bpt.make_cursor(); c; c.next()) {
+				auto leaf = bpt.get_accessor().load_leaf(c.node_id());
+				const auto* idx = leaf.heads_index();
+				CHECK((idx != nullptr) == (heads > 0));
+				indexed_leafs += (idx && idx->count.get() == leaf.size()) ? 1 : 0;
+				++leafs;
+				parents.insert(leaf.get_parent());
+			}
+			for (auto id : parents) {
+				auto inode = bpt.get_accessor().load_inode(id);
+				REQUIRE(inode.is_valid());
+				const auto* idx = inode.heads_index();
+				CHECK((idx != nullptr) == (heads > 0));
+				indexed += (idx && idx->count.get() == inode.size()) ? 1 : 0;
+			}
+			if (heads == 256) {
+				CHECK(indexed == parents.size());
+				CHECK(indexed_leafs == leafs);
+			}
+
+			std::vector<std::string> keys(test.begin(), test.end());
+			std::mt19937 rng(0x4EAD);
+			std::ranges::shuffle(keys, rng);
+			for (std::size_t i = 0; i < keys.size(); i += 3) {
+				CHECK(bpt.remove(as_key_like(keys[i])));
+				test.erase(keys[i]);
+			}
+
+			std::vector<std::string> probes = { "", "/", "/usr/lib", "/usr/lib/", "/usr/libe", "/zzz" };
+			for (int i = 0; i < 500; ++i) {
+				probes.push_back(dirs[i % dirs.size()] + get_random_string(0, 12));
+			}
+			for (auto& probe : probes) {
+				auto lower = bpt.lower_bound(as_key_like(probe));
+				auto ref_lower = test.lower_bound(probe);
+				if (ref_lower == test.end()) {
+					CHECK(lower == bpt.end());
+				}
+				else {
+					REQUIRE(lower != bpt.end());
+					CHECK(as_string(lower->second) == *ref_lower);
+				}
+			}
+			for (auto& key : test) {
+				CHECK(bpt.find(as_key_like(key)) != bpt.end());
+			}
+			if (heads == 256) {
+				for (auto c = bpt.make_cursor(); c; c.next()) {
+					auto leaf = bpt.get_accessor().load_leaf(c.node_id());
+					const auto* idx = leaf.heads_index();
+					REQUIRE(idx != nullptr);
+					CHECK(idx->count.get() == leaf.size());
+				}
+			}
+		}
+	}
+
+	TEST_CASE("leaf fingerprints") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		static_assert(fulla::bpt::concepts::LeafFindKey<typename model_type::leaf_type, key_like_type>);
+
+		// alone and behind the key heads block
+		for (std::size_t heads : { 0, 256 }) {
+			memory_block_device mem(DEFAULT_BUFFER_SIZE);
+			BM bm(mem, 32);
+			paged::settings sett;
+			sett.leaf_search_heads = heads;
+			sett.leaf_fingerprints = 256;
+			bpt_type bpt(bm, sett);
+
+			std::set<std::string> test;
+			for (int i = 0; i < 5000; ++i) {
+				auto key = get_random_string(1, 16);
+				const bool inserted = test.insert(key).second;
+				CHECK(bpt.insert(as_key_like(key), as_value_in(key)) == inserted);
+			}
+
+			auto check_leafs = [&]() {
+				std::set<typename model_type::node_id_type> leafs;
+				for (auto c = bpt.make_cursor(); c; c.next()) {
+					leafs.insert(c.node_id());
+				}
+				for (auto id : leafs) {
+					auto leaf = bpt.get_accessor().load_leaf(id);
+					const auto* fps = leaf.fingerprints();
+					REQUIRE(fps != nullptr);
+					REQUIRE(fps->count.get() == leaf.size());
+					CHECK((leaf.heads_index() != nullptr) == (heads > 0));
+					for (std::size_t i = 0; i < leaf.size(); ++i) {
+						CHECK(static_cast<std::uint8_t>(fps->prints()[i])
+							== fulla::page::bpt_key_fingerprints::make_fingerprint(leaf.get_key(i).key));
+					}
+				}
+			};
+			check_leafs();
+
+			std::vector<std::string> keys(test.begin(), test.end());
+			std::mt19937 rng(0xF1F1);
+			std::ranges::shuffle(keys, rng);
+			for (std::size_t i = 0; i < keys.size(); i += 3) {
+				CHECK(bpt.remove(as_key_like(keys[i])));
+				test.erase(keys[i]);
+			}
+			check_leafs();
+
+			for (auto& key : keys) {
+				auto found = bpt.find(as_key_like(key));
+				if (test.contains(key)) {
+					REQUIRE(found != bpt.end());
+					CHECK(as_string(found->second) == key);
+				}
+				else {
+					CHECK(found == bpt.end());
+				}
+			}
+			for (int i = 0; i < 1000; ++i) {
+				auto key = get_random_string(17, 20);
+				CHECK(bpt.find(as_key_like(key)) == bpt.end());
+			}
+		}
+	}
+
+	TEST_CASE("inode right-links") {
+		using BM = buffer_manager<memory_block_device>;
+		using root_manager_type = paged::memory_root_manager<typename BM::pid_type>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less, root_manager_type, paged::blink_bpt_descriptor>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		using node_id_type = typename model_type::node_id_type;
+		static_assert(bpt_type::has_inode_links);
+		// only B-link models pay for the link in the inode subheader
+		static_assert(!fulla::bpt::tree<paged::model<BM, fulla::page::bytewise_less>>::has_inode_links);
+		static_assert(sizeof(typename paged::model<BM>::inode_header_type) == 8);
+
+		// every level, read left to right through the parents, is one chain of right-links;
+		// a search started at the left end of any level finds every key
+		auto check_links = [](bpt_type& bpt, const std::set<std::string>& test) {
+			auto& accessor = bpt.get_accessor();
+			auto [root, exists] = accessor.load_root();
+			REQUIRE(exists);
+			std::vector<node_id_type> level{ root };
+			std::vector<node_id_type> starts;
+			while (!bpt.model_.is_leaf_id(level.front())) {
+				starts.push_back(level.front());
+				std::vector<node_id_type> below;
+				for (std::size_t i = 0; i < level.size(); ++i) {
+					auto inode = accessor.load_inode(level[i]);
+					const auto next = inode.get_next();
+					if (i + 1 < level.size()) {
+						CHECK(next == level[i + 1]);
+					}
+					else {
+						CHECK_FALSE(bpt.model_.is_valid_id(next));
+					}
+					for (std::size_t c = 0; c <= inode.size(); ++c) {
+						below.push_back(inode.get_child(c));
+					}
+				}
+				level = std::move(below);
+			}
+			starts.push_back(level.front());
+			for (auto start : starts) {
+				for (auto& key : test) {
+					auto res = bpt.locate_(as_key_like(key), start);
+					REQUIRE(res.found);
+					CHECK(as_string(accessor.load_leaf(res.node).get_value(res.pos)) == key);
+				}
+				CHECK_FALSE(bpt.locate_(as_key_like("~~~"), start).found);
+			}
+		};
+
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, 32);
+		bpt_type bpt(bm);
+		std::set<std::string> test;
+		for (int i = 0; i < 6000; ++i) {
+			auto key = get_random_string(8, 40);
+			test.insert(key);
+			bpt.insert(as_key_like(key), as_value_in(key));
+		}
+		check_links(bpt, test);
+
+		std::vector<std::string> keys(test.begin(), test.end());
+		std::mt19937 rng(0xB11C);
+		std::ranges::shuffle(keys, rng);
+		// merges splice nodes out of the chains
+		for (std::size_t i = 0; i < keys.size(); ++i) {
+			if (i % 3 != 0) {
+				CHECK(bpt.remove(as_key_like(keys[i])));
+				test.erase(keys[i]);
+			}
+		}
+		check_links(bpt, test);
+
+		memory_block_device bulk_mem(DEFAULT_BUFFER_SIZE);
+		BM bulk_bm(bulk_mem, 32);
+		bpt_type bulk(bulk_bm);
+		std::vector<std::pair<key_like_type, value_in_type>> input;
+		for (auto& key : test) {
+			input.emplace_back(as_key_like(key), as_value_in(key));
+		}
+		REQUIRE(bulk.bulk_load(input, 0.7));
+		check_links(bulk, test);
+	}
+
+	TEST_CASE("child counts") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less, paged::memory_root_manager<typename BM::pid_type>, paged::counted_bpt_descriptor>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		using node_id_type = typename model_type::node_id_type;
+		static_assert(bpt_type::has_child_counts);
+		static_assert(!fulla::bpt::tree<paged::model<BM, fulla::page::bytewise_less>>::has_child_counts);
+
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, 32);
+		bpt_type bpt(bm);
+
+		std::function<std::size_t(node_id_type)> check_counts = [&](node_id_type id) -> std::size_t {
+			if (bpt.model_.is_leaf_id(id)) {
+				return bpt.get_accessor().load_leaf(id).size();
+			}
+			auto inode = bpt.get_accessor().load_inode(id);
+			std::size_t total = 0;
+			for (std::size_t i = 0; i <= inode.size(); ++i) {
+				const auto count = check_counts(inode.get_child(i));
+				CHECK(inode.get_count(i) == count);
+				total += count;
+			}
+			return total;
+		};
+
+		std::set<std::string> test;
+		auto check_all = [&]() {
+			auto [root, exists] = bpt.get_accessor().load_root();
+			REQUIRE(exists);
+			CHECK(check_counts(root) == test.size());
+			std::size_t i = 0;
+			for (auto& key : test) {
+				if (i % 7 == 0) {
+					CHECK(bpt.rank(as_key_like(key)) == i);
+					auto it = bpt.nth(i);
+					REQUIRE(it != bpt.end());
+					CHECK(as_string(it->second) == key);
+					CHECK((bpt.begin() + static_cast<std::ptrdiff_t>(i)) == it);
+				}
+				++i;
+			}
+			CHECK(bpt.nth(test.size()) == bpt.end());
+			CHECK(bpt.count(as_key_like("A"), as_key_like("N")) == static_cast<std::size_t>(
+				std::distance(test.lower_bound("A"), test.lower_bound("N"))));
+		};
+
+		for (int i = 0; i < 6000; ++i) {
+			auto key = get_random_string(4, 40);
+			test.insert(key);
+			bpt.insert(as_key_like(key), as_value_in(key));
+		}
+		check_all();
+
+		std::vector<std::string> keys(test.begin(), test.end());
+		std::mt19937 rng(0xC0C0);
+		std::ranges::shuffle(keys, rng);
+		for (std::size_t i = 0; i < keys.size(); ++i) {
+			if (i % 3 != 0) {
+				CHECK(bpt.remove(as_key_like(keys[i])));
+				test.erase(keys[i]);
+			}
+		}
+		check_all();
+		REQUIRE(bpt.compact(0.8));
+		check_all();
+	}
+
+	TEST_CASE("compact") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, 16);
+		bpt_type bpt(bm);
+
+		std::set<std::string> test;
+		while (test.size() < 5000) {
+			auto key = get_random_string(4, 40);
+			if (test.insert(key).second) {
+				REQUIRE(bpt.insert(as_key_like(key), as_value_in(key)));
+			}
+		}
+		std::size_t i = 0;
+		for (auto itr = test.begin(); itr != test.end(); ++i) {
+			if (i % 4 != 0) {
+				REQUIRE(bpt.remove(as_key_like(*itr)));
+				itr = test.erase(itr);
+			}
+			else {
+				++itr;
+			}
+		}
+
+		const auto report = bpt.compact();
+		REQUIRE(report);
+		CHECK(report->before.elements == test.size());
+		CHECK(report->after.elements == test.size());
+		CHECK(report->after.leaves < report->before.leaves);
+		CHECK(report->after.fill > report->before.fill);
+		CHECK(report->before.fragmentation > 0.2);
+		CHECK(report->after.fragmentation == 0.0);
+
+		auto it = bpt.begin();
+		for (auto& key : test) {
+			REQUIRE(it != bpt.end());
+			CHECK(as_string(it->second) == key);
+			++it;
+		}
+		CHECK(it == bpt.end());
+
+		// the rebuilt tree takes regular updates
+		for (int n = 0; n < 2000; ++n) {
+			auto key = get_random_string(4, 40);
+			if (test.insert(key).second) {
+				REQUIRE(bpt.insert(as_key_like(key), as_value_in(key)));
+			}
+		}
+		for (auto& key : test) {
+			CHECK(bpt.find(as_key_like(key)) != bpt.end());
+		}
+		CHECK(bpt.layout().elements == test.size());
+	}
+
+	TEST_CASE("compact without free frames leaves the tree as it was") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+
+		constexpr std::size_t frames = 16;
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, frames);
+		bpt_type bpt(bm);
+
+		std::set<std::string> test;
+		while (test.size() < 3000) {
+			auto key = get_random_string(4, 40);
+			if (test.insert(key).second) {
+				REQUIRE(bpt.insert(as_key_like(key), as_value_in(key)));
+			}
+		}
+		std::size_t i = 0;
+		for (auto itr = test.begin(); itr != test.end(); ++i) {
+			if (i % 3 != 0) {
+				REQUIRE(bpt.remove(as_key_like(*itr)));
+				itr = test.erase(itr);
+			}
+			else {
+				++itr;
+			}
+		}
+
+		// pin all but `spare` frames, so the rebuild runs out of them part way through
+		std::size_t failures = 0;
+		for (std::size_t spare = 2; spare < frames; ++spare) {
+			std::vector<typename BM::page_handle> pinned;
+			for (typename BM::pid_type pid = 0; pinned.size() < frames - spare; ++pid) {
+				pinned.emplace_back(bm.fetch(pid));
+				REQUIRE(pinned.back().is_valid());
+			}
+			const auto report = bpt.compact();
+			pinned.clear();
+			if (report) {
+				break;
+			}
+			++failures;
+			auto it = bpt.begin();
+			for (auto& key : test) {
+				REQUIRE(it != bpt.end());
+				CHECK(as_string(it->second) == key);
+				++it;
+			}
+			CHECK(it == bpt.end());
+		}
+		CHECK(failures > 0);
+		CHECK(bpt.layout().elements == test.size());
+	}
+
+	TEST_CASE("append mode") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, 16);
+		bpt_type plain(bm);
+		bpt_type appended(bm);
+		appended.set_append_mode(true);
+
+		std::vector<std::string> keys;
+		for (int i = 0; i < 20000; ++i) {
+			keys.push_back("event:" + std::to_string(10000000 + i));
+			REQUIRE(plain.insert(as_key_like(keys.back()), as_value_in(keys.back())));
+			REQUIRE(appended.insert(as_key_like(keys.back()), as_value_in(keys.back())));
+		}
+		const auto plain_stats = plain.layout();
+		const auto stats = appended.layout();
+		CHECK(stats.elements == keys.size());
+		CHECK(plain_stats.fill < 0.6);
+		CHECK(stats.fill > 0.9);
+		CHECK(stats.leaves * 3 < plain_stats.leaves * 2);
+
+		auto it = appended.begin();
+		for (auto& key : keys) {
+			REQUIRE(it != appended.end());
+			CHECK(as_string(it->second) == key);
+			++it;
+		}
+		CHECK(it == appended.end());
+		CHECK(appended.find(as_key_like(keys[12345])) != appended.end());
+	}
+
+	TEST_CASE("append mode without free frames") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+
+		constexpr std::size_t frames = 8;
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, frames);
+		bpt_type bpt(bm);
+		bpt.set_append_mode(true);
+
+		// fill the root leaf up to the key that opens a second leaf
+		std::vector<std::string> keys;
+		while (bpt.layout().leaves < 2) {
+			keys.push_back("event:" + std::to_string(10000000 + keys.size()));
+			REQUIRE(bpt.insert(as_key_like(keys.back()), as_value_in(keys.back())));
+		}
+		REQUIRE(bpt.remove(as_key_like(keys.back())));
+		REQUIRE(bpt.layout().leaves == 1);
+		const auto last = keys.back();
+		keys.pop_back();
+
+		// the new root and the new leaf can't both be allocated until enough frames are free
+		std::size_t failures = 0;
+		for (std::size_t spare = 1; spare < frames; ++spare) {
+			std::vector<typename BM::page_handle> pinned;
+			while (pinned.size() < frames - spare) {
+				pinned.emplace_back(bm.create());
+				REQUIRE(pinned.back().is_valid());
+			}
+			const bool inserted = bpt.insert(as_key_like(last), as_value_in(last));
+			pinned.clear();
+			if (inserted) {
+				break;
+			}
+			++failures;
+			CHECK(bpt.find(as_key_like(last)) == bpt.end());
+			CHECK(bpt.layout().elements == keys.size());
+		}
+		CHECK(failures > 0);
+		keys.push_back(last);
+
+		auto it = bpt.begin();
+		for (auto& key : keys) {
+			REQUIRE(it != bpt.end());
+			CHECK(as_string(it->second) == key);
+			++it;
+		}
+		CHECK(it == bpt.end());
+	}
+
+	TEST_CASE("find_many") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, 12);
+		bpt_type bpt(bm);
+
+		std::set<std::string> test;
+		while (test.size() < 8000) {
+			auto key = get_random_string(4, 40);
+			if (test.insert(key).second) {
+				REQUIRE(bpt.insert(as_key_like(key), as_value_in(key)));
+			}
+		}
+
+		std::vector<std::string> probes;
+		std::size_t i = 0;
+		for (auto& key : test) {
+			if (i++ % 9 == 0) {
+				probes.push_back(key);
+				probes.push_back(key + "~");
+			}
+		}
+		std::mt19937 rng(0x3A11);
+		std::ranges::shuffle(probes, rng);
+		std::vector<key_like_type> keys;
+		for (auto& p : probes) {
+			keys.push_back(as_key_like(p));
+		}
+
+		const auto found = bpt.find_many(keys);
+		REQUIRE(found.size() == probes.size());
+		for (std::size_t n = 0; n < probes.size(); ++n) {
+			if (test.contains(probes[n])) {
+				REQUIRE(found[n] != bpt.end());
+				CHECK(as_string(found[n]->second) == probes[n]);
+			}
+			else {
+				CHECK(found[n] == bpt.end());
+			}
+		}
+	}
+
+	TEST_CASE("overflow values") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less,
+			paged::memory_root_manager<typename BM::pid_type>, paged::overflow_bpt_descriptor>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		using overflow_value_in = typename model_type::value_in_type;
+
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, 16);
+		paged::settings sett;
+		sett.leaf_value_overflow = 64;
+		bpt_type bpt(bm, sett);
+
+		std::mt19937 rng(0x0F10);
+		const auto make_value = [&](std::size_t len) {
+			std::string res(len, '\0');
+			for (auto& c : res) {
+				c = static_cast<char>('a' + rng() % 26);
+			}
+			return res;
+		};
+		const auto value_in = [](const std::string& val) {
+			return overflow_value_in{ .val = byte_view{ reinterpret_cast<const byte*>(val.data()), val.size() } };
+		};
+		const auto loaded = [](const auto& vout) {
+			const auto data = vout.load();
+			return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+		};
+
+		std::map<std::string, std::string> test;
+		for (int i = 0; i < 1500; ++i) {
+			auto key = "doc:" + std::to_string(100000 + i);
+			const std::size_t len = (i % 3 == 0) ? rng() % 48 : rng() % 9000;
+			test[key] = make_value(len);
+			REQUIRE(bpt.insert(as_key_like(key), value_in(test[key])));
+		}
+
+		const auto check_all = [&]() {
+			auto it = bpt.begin();
+			for (auto& [key, val] : test) {
+				REQUIRE(it != bpt.end());
+				CHECK(std::ranges::equal(it->first.key, as_key_like(key).key));
+				CHECK(it->second.size() == val.size());
+				CHECK(it->second.is_external() == (val.size() > 64));
+				CHECK(loaded(it->second) == val);
+				++it;
+			}
+			CHECK(it == bpt.end());
+		};
+		check_all();
+		// only references in the leaves: about 20 bytes per value
+		CHECK(bpt.layout().leaves < 40);
+
+		{
+			auto found = bpt.find(as_key_like("doc:100004"));
+			REQUIRE(found != bpt.end());
+			const auto& val = test["doc:100004"];
+			std::string part(100, '\0');
+			const auto got = found->second.read(val.size() - 50,
+				{ reinterpret_cast<byte*>(part.data()), part.size() });
+			CHECK(got == 50);
+			CHECK(part.substr(0, 50) == val.substr(val.size() - 50));
+		}
+
+		// values grow, shrink and move between inline and out of line
+		std::size_t n = 0;
+		for (auto& [key, val] : test) {
+			if (n++ % 4 == 0) {
+				val = make_value((n % 8 == 1) ? rng() % 30 : rng() % 5000);
+				REQUIRE(bpt.update(as_key_like(key), value_in(val)));
+			}
+		}
+		check_all();
+
+		n = 0;
+		for (auto itr = test.begin(); itr != test.end(); ++n) {
+			if (n % 3 == 1) {
+				REQUIRE(bpt.remove(as_key_like(itr->first)));
+				itr = test.erase(itr);
+			}
+			else {
+				++itr;
+			}
+		}
+		check_all();
+
+		// compact moves the references, not the chains
+		REQUIRE(bpt.compact());
+		check_all();
+
+		const auto first = test.lower_bound("doc:100300");
+		const auto last = test.lower_bound("doc:101200");
+		const auto expected = static_cast<std::size_t>(std::distance(first, last));
+		test.erase(first, last);
+		CHECK(bpt.erase_range(as_key_like("doc:100300"), as_key_like("doc:101200")) == expected);
+		check_all();
+	}
+
+	TEST_CASE("erase_range") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less, paged::memory_root_manager<typename BM::pid_type>, paged::counted_bpt_descriptor>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		using node_id_type = typename model_type::node_id_type;
+
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, 32);
+		bpt_type bpt(bm);
+
+		std::function<std::size_t(node_id_type)> check_counts = [&](node_id_type id) -> std::size_t {
+			if (bpt.model_.is_leaf_id(id)) {
+				return bpt.get_accessor().load_leaf(id).size();
+			}
+			auto inode = bpt.get_accessor().load_inode(id);
+			std::size_t total = 0;
+			for (std::size_t i = 0; i <= inode.size(); ++i) {
+				const auto count = check_counts(inode.get_child(i));
+				CHECK(inode.get_count(i) == count);
+				total += count;
+			}
+			return total;
+		};
+
+		std::map<std::string, std::string> test;
+		const auto key_of = [](int i) {
+			auto key = std::to_string(i);
+			return "log:" + std::string(8 - key.size(), '0') + key;
+		};
+		const auto fill = [&](int from, int to) {
+			for (int i = from; i < to; ++i) {
+				const auto key = key_of(i);
+				if (!test.contains(key)) {
+					test[key] = "entry #" + std::to_string(i);
+					REQUIRE(bpt.insert(as_key_like(key), as_value_in(test[key])));
+				}
+			}
+		};
+		const auto check_all = [&]() {
+			auto it = bpt.begin();
+			for (auto& [key, val] : test) {
+				REQUIRE(it != bpt.end());
+				CHECK(std::ranges::equal(it->first.key, as_key_like(key).key));
+				CHECK(std::ranges::equal(it->second.val, as_value_in(val).val));
+				++it;
+			}
+			CHECK(it == bpt.end());
+			auto [root, exists] = bpt.get_accessor().load_root();
+			CHECK(exists == !test.empty());
+			if (exists) {
+				CHECK(check_counts(root) == test.size());
+			}
+		};
+
+		fill(0, 20000);
+		check_all();
+		const auto pages = bpt.layout().leaves + bpt.layout().inodes;
+
+		// retention: drop the oldest part in one call
+		test.erase(test.begin(), test.lower_bound(key_of(15000)));
+		CHECK(bpt.erase_range(as_key_like(key_of(0)), as_key_like(key_of(15000))) == 15000);
+		check_all();
+		CHECK(bpt.layout().leaves + bpt.layout().inodes < pages / 3);
+
+		fill(0, 15000);
+		std::mt19937 rng(0xE2A5);
+		for (int round = 0; round < 60; ++round) {
+			const int lo = static_cast<int>(rng() % 21000) - 500;
+			const int hi = lo + static_cast<int>(rng() % (round % 2 == 0 ? 6000 : 50));
+			const auto first = test.lower_bound(key_of(std::max(lo, 0)));
+			const auto last = test.lower_bound(key_of(std::max(hi, 0)));
+			const auto expected = static_cast<std::size_t>(std::distance(first, last));
+			test.erase(first, last);
+			REQUIRE(bpt.erase_range(as_key_like(key_of(std::max(lo, 0))), as_key_like(key_of(std::max(hi, 0)))) == expected);
+			if (round % 10 == 0) {
+				check_all();
+			}
+			if (test.size() < 5000) {
+				fill(static_cast<int>(rng() % 5000), 20000);
+			}
+		}
+		check_all();
+
+		CHECK(bpt.erase_range(as_key_like("log:"), as_key_like("log:~")) == test.size());
+		test.clear();
+		check_all();
+		fill(0, 1000);
+		check_all();
+	}
+
+	TEST_CASE("split_at and join") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less, paged::memory_root_manager<typename BM::pid_type>, paged::counted_bpt_descriptor>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		using node_id_type = typename model_type::node_id_type;
+		static_assert(fulla::bpt::concepts::ModelSharedNodes<model_type>);
+
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, 32);
+		bpt_type left(bm);
+		bpt_type right(bm);
+
+		std::vector<std::string> keys;
+		for (int i = 0; i < 20000; ++i) {
+			auto num = std::to_string(i * 2);
+			keys.push_back("key:" + std::string(8 - num.size(), '0') + num);
+			REQUIRE(left.insert(as_key_like(keys.back()), as_value_in("value of " + keys.back())));
+		}
+
+		const auto check_tree = [&](bpt_type& t, std::size_t from, std::size_t to) {
+			std::function<std::size_t(node_id_type)> check_counts = [&](node_id_type id) -> std::size_t {
+				if (t.model_.is_leaf_id(id)) {
+					return t.get_accessor().load_leaf(id).size();
+				}
+				auto inode = t.get_accessor().load_inode(id);
+				std::size_t total = 0;
+				for (std::size_t i = 0; i <= inode.size(); ++i) {
+					const auto count = check_counts(inode.get_child(i));
+					CHECK(inode.get_count(i) == count);
+					total += count;
+				}
+				return total;
+			};
+			auto it = t.begin();
+			for (auto i = from; i < to; ++i) {
+				REQUIRE(it != t.end());
+				CHECK(std::ranges::equal(it->first.key, as_key_like(keys[i]).key));
+				CHECK(std::ranges::equal(it->second.val, as_value_in("value of " + keys[i]).val));
+				++it;
+			}
+			CHECK(it == t.end());
+			auto back = t.end();
+			for (auto i = to; i > from; --i) {
+				--back;
+				REQUIRE(std::ranges::equal(back->first.key, as_key_like(keys[i - 1]).key));
+			}
+			auto [root, exists] = t.get_accessor().load_root();
+			CHECK(exists == (from < to));
+			if (exists) {
+				CHECK(check_counts(root) == to - from);
+			}
+		};
+
+		const auto pages = left.layout().leaves;
+		REQUIRE(left.split_at(as_key_like(keys[12345]), right));
+		check_tree(left, 0, 12345);
+		check_tree(right, 12345, keys.size());
+		// the nodes change hands, nothing is copied
+		CHECK(left.layout().leaves + right.layout().leaves <= pages + 1);
+
+		REQUIRE(left.join(right));
+		check_tree(left, 0, keys.size());
+		check_tree(right, 0, 0);
+
+		// a key between two stored ones, below all of them and past all of them
+		REQUIRE(left.split_at(as_key_like(keys[777] + "!"), right));
+		check_tree(left, 0, 778);
+		check_tree(right, 778, keys.size());
+		REQUIRE(left.join(right));
+		REQUIRE(left.split_at(as_key_like("a"), right));
+		check_tree(left, 0, 0);
+		check_tree(right, 0, keys.size());
+		REQUIRE(right.split_at(as_key_like("z"), left));
+		check_tree(right, 0, keys.size());
+		check_tree(left, 0, 0);
+
+		// trees of different heights, either side the taller one
+		std::mt19937 rng(0x5B17);
+		for (int round = 0; round < 20; ++round) {
+			const auto at = (round % 4 == 0) ? rng() % 40 : keys.size() - 1 - rng() % 40;
+			REQUIRE(right.split_at(as_key_like(keys[at]), left));
+			check_tree(right, 0, at);
+			check_tree(left, at, keys.size());
+			REQUIRE(right.join(left));
+			check_tree(right, 0, keys.size());
+		}
+		for (int round = 0; round < 20; ++round) {
+			const auto at = rng() % keys.size();
+			REQUIRE(right.split_at(as_key_like(keys[at]), left));
+			REQUIRE(right.join(left));
+		}
+		check_tree(right, 0, keys.size());
+
+		// both halves stay regular trees
+		REQUIRE(right.split_at(as_key_like(keys[9000]), left));
+		for (std::size_t i = 0; i < keys.size(); i += 3) {
+			auto& t = (i < 9000) ? right : left;
+			REQUIRE(t.remove(as_key_like(keys[i])));
+			REQUIRE(t.insert(as_key_like(keys[i]), as_value_in("value of " + keys[i])));
+		}
+		check_tree(right, 0, 9000);
+		check_tree(left, 9000, keys.size());
+		REQUIRE(right.join(left));
+		check_tree(right, 0, keys.size());
+	}
+
+	TEST_CASE("split_at, join and erase_range without parent links") {
+		using BM = buffer_manager<memory_block_device>;
+		using model_type = paged::model<BM, fulla::page::bytewise_less, paged::memory_root_manager<typename BM::pid_type>, paged::parentless_bpt_descriptor>;
+		using bpt_type = fulla::bpt::tree<model_type>;
+		static_assert(!bpt_type::has_parent_links);
+
+		memory_block_device mem(DEFAULT_BUFFER_SIZE);
+		BM bm(mem, 32);
+		bpt_type left(bm);
+		bpt_type right(bm);
+
+		std::map<std::string, std::string> test;
+		for (int i = 0; i < 8000; ++i) {
+			auto num = std::to_string(i);
+			auto key = "k" + std::string(6 - num.size(), '0') + num;
+			test[key] = "v" + num;
+			REQUIRE(left.insert(as_key_like(key), as_value_in(test[key])));
+		}
+		const auto check_tree = [&](bpt_type& t, const std::string& from, const std::string& to) {
+			auto it = t.begin();
+			for (auto ref = test.lower_bound(from); ref != test.lower_bound(to); ++ref) {
+				REQUIRE(it != t.end());
+				CHECK(std::ranges::equal(it->first.key, as_key_like(ref->first).key));
+				CHECK(std::ranges::equal(it->second.val, as_value_in(ref->second).val));
+				++it;
+			}
+			CHECK(it == t.end());
+		};
+
+		REQUIRE(left.split_at(as_key_like("k003000"), right));
+		check_tree(left, "", "k003000");
+		check_tree(right, "k003000", "z");
+
+		test.erase(test.lower_bound("k001000"), test.lower_bound("k002000"));
+		CHECK(left.erase_range(as_key_like("k001000"), as_key_like("k002000")) == 1000);
+		test.erase(test.lower_bound("k004000"), test.lower_bound("k007500"));
+		CHECK(right.erase_range(as_key_like("k004000"), as_key_like("k007500")) == 3500);
+		check_tree(left, "", "k003000");
+		check_tree(right, "k003000", "z");
+
+		REQUIRE(left.join(right));
+		check_tree(left, "", "z");
+		check_tree(right, "z", "z");
+		for (auto& [key, val] : test) {
+			REQUIRE(left.remove(as_key_like(key)));
+		}
+		CHECK(left.begin() == left.end());
+	}
 }
@@ -136,4 +136,66 @@ TEST_SUITE("storage/buffer_manager") {
         CHECK(p2.is_valid());
 
     }
+
+    TEST_CASE("resize grows and shrinks the pool") {
+        memory_block_device device(256);
+        using BM = buffer_manager<memory_block_device>;
+        BM bm(device, 2);
+        CHECK(bm.maximum_pages() == 2);
+
+        auto p0 = bm.create();
+        auto p1 = bm.create();
+        CHECK(p0.is_valid());
+        CHECK(p1.is_valid());
+        CHECK_FALSE(bm.create().is_valid());
+
+        CHECK(bm.resize(4) == 4);
+        auto p2 = bm.create();
+        auto p3 = bm.create();
+        CHECK(p2.is_valid());
+        CHECK(p3.is_valid());
+        CHECK(bm.resident_pages() == 4);
+
+        p2.rw_span()[0] = byte{ 0x42 };
+        p2.mark_dirty();
+        const auto id2 = p2.pid();
+        p2 = {};
+        p3 = {};
+
+        SUBCASE("shrink evicts unpinned pages only") {
+            CHECK(bm.resize(1) == 2);
+            CHECK(bm.resident_pages() == 2);
+            CHECK(p0.is_valid());
+            CHECK(p1.is_valid());
+
+            p1 = {};
+            CHECK(bm.resize(1) == 1);
+            CHECK(p0.is_valid());
+
+            CHECK_FALSE(bm.fetch(id2).is_valid());
+            p0 = {};
+            auto ph = bm.fetch(id2);
+            REQUIRE(ph.is_valid());
+            CHECK(ph.ro_span()[0] == byte{ 0x42 });
+        }
+
+        SUBCASE("shrink releases free frames first") {
+            bm.evict(id2);
+            CHECK(bm.resize(3) == 3);
+            CHECK(bm.resident_pages() == 3);
+
+            // the evicted frame is gone from the LRU list as well; the pool keeps working
+            for (int round = 0; round < 4; ++round) {
+                {
+                    auto ph = bm.fetch(id2);
+                    REQUIRE(ph.is_valid());
+                    CHECK(ph.ro_span()[0] == byte{ 0x42 });
+                    CHECK_FALSE(bm.create().is_valid());
+                }
+                auto fresh = bm.create();
+                CHECK(fresh.is_valid());
+            }
+            CHECK(bm.resident_pages() == 3);
+        }
+    }
 }
@@ -0,0 +1,155 @@
+// tests/test_buffer_pool.cpp
+#include "tests.hpp"
+
+#include <map>
+
+#include "fulla/core/bytes.hpp"
+#include "fulla/storage/memory_block_device.hpp"
+#include "fulla/storage/buffer_pool.hpp"
+#include "fulla/page_allocator/pooled.hpp"
+#include "fulla/bpt/paged/model.hpp"
+#include "fulla/bpt/tree.hpp"
+#include "fulla/codec/prop.hpp"
+
+using namespace fulla::core;
+using namespace fulla::storage;
+
+namespace {
+    using pool_type = buffer_pool<memory_block_device>;
+    using allocator_type = fulla::page_allocator::pooled<memory_block_device>;
+}
+
+TEST_SUITE("storage/buffer_pool") {
+
+    TEST_CASE("pages of several devices share frames") {
+        memory_block_device dev0(256);
+        memory_block_device dev1(256);
+        pool_type pool(256, 3);
+
+        const auto id0 = pool.attach(dev0);
+        const auto id1 = pool.attach(dev1);
+        CHECK(id0 != id1);
+
+        auto a0 = pool.create(id0);
+        auto b0 = pool.create(id1);
+        REQUIRE(a0.is_valid());
+        REQUIRE(b0.is_valid());
+
+        // the same pid on different devices are different pages
+        CHECK(a0.pid() == 0);
+        CHECK(b0.pid() == 0);
+        CHECK_FALSE(a0 == b0);
+        CHECK(a0.device_id() == id0);
+        CHECK(b0.device_id() == id1);
+
+        a0.rw_span()[0] = byte{ 0x0A };
+        a0.mark_dirty();
+        b0.rw_span()[0] = byte{ 0x0B };
+        b0.mark_dirty();
+
+        auto a1 = pool.create(id0);
+        REQUIRE(a1.is_valid());
+        CHECK(pool.resident_pages() == 3);
+        CHECK(pool.resident_pages(id0) == 2);
+        CHECK(pool.resident_pages(id1) == 1);
+
+        // all frames are pinned
+        CHECK_FALSE(pool.create(id1).is_valid());
+
+        // device 0 releases a page and device 1 borrows the frame
+        a0 = {};
+        auto b1 = pool.create(id1);
+        REQUIRE(b1.is_valid());
+        CHECK(pool.resident_pages(id0) == 1);
+        CHECK(pool.resident_pages(id1) == 2);
+
+        b0 = {};
+        b1 = {};
+        auto r0 = pool.fetch(id0, 0);
+        REQUIRE(r0.is_valid());
+        CHECK(r0.ro_span()[0] == byte{ 0x0A });
+        r0 = {};
+        auto r1 = pool.fetch(id1, 0);
+        REQUIRE(r1.is_valid());
+        CHECK(r1.ro_span()[0] == byte{ 0x0B });
+    }
+
+    TEST_CASE("detach drops device pages and frees the id") {
+        memory_block_device dev0(256);
+        memory_block_device dev1(256);
+        pool_type pool(256, 4);
+
+        const auto id0 = pool.attach(dev0);
+        {
+            auto ph = pool.create(id0);
+            ph.rw_span()[1] = byte{ 0x11 };
+            ph.mark_dirty();
+        }
+        pool.detach(id0);
+        CHECK_FALSE(pool.valid_device_id(id0));
+        CHECK(pool.resident_pages() == 0);
+        CHECK(pool.attach(dev1) == id0);
+
+        // dirty pages are written back on detach
+        byte check[2]{};
+        CHECK(dev0.read_block(0, check, 2));
+        CHECK(check[1] == byte{ 0x11 });
+    }
+
+    TEST_CASE("resize the shared pool") {
+        memory_block_device dev0(256);
+        pool_type pool(256, 2);
+        const auto id0 = pool.attach(dev0);
+
+        auto p0 = pool.create(id0);
+        CHECK(pool.resize(8) == 8);
+        for (int i = 0; i < 6; ++i) {
+            CHECK(pool.create(id0).is_valid());
+        }
+        CHECK(pool.resize(1) == 1);
+        CHECK(p0.is_valid());
+        CHECK(pool.resident_pages() == 1);
+    }
+
+    TEST_CASE("bpt trees of two devices on one pool") {
+        using model_type = fulla::bpt::paged::model<allocator_type>;
+        using tree_type = fulla::bpt::tree<model_type>;
+        using key_like_type = typename model_type::key_like_type;
+        using value_in_type = typename model_type::value_in_type;
+
+        memory_block_device dev0(4096);
+        memory_block_device dev1(4096);
+        pool_type pool(4096, 16);
+
+        allocator_type alloc0(pool, dev0);
+        allocator_type alloc1(pool, dev1);
+        tree_type tree0(alloc0);
+        tree_type tree1(alloc1);
+
+        std::map<std::string, std::string> expected;
+        for (int i = 0; i < 2000; ++i) {
+            const auto key = std::to_string(i * 7919 % 10007);
+            auto rec = fulla::codec::prop::make_record(fulla::codec::prop::str{ key });
+            const auto value = "value_" + key;
+            value_in_type vin{ byte_view{ reinterpret_cast<const byte*>(value.data()), value.size() } };
+            CHECK(tree0.insert(key_like_type{ rec.view() }, vin));
+            CHECK(tree1.insert(key_like_type{ rec.view() }, vin));
+            expected[key] = value;
+        }
+        CHECK(pool.resident_pages() <= 16);
+        CHECK(pool.resident_pages(alloc0.device_id()) > 0);
+        CHECK(pool.resident_pages(alloc1.device_id()) > 0);
+
+        for (const auto& [k, v] : expected) {
+            auto rec = fulla::codec::prop::make_record(fulla::codec::prop::str{ k });
+            auto it0 = tree0.find(key_like_type{ rec.view() });
+            auto it1 = tree1.find(key_like_type{ rec.view() });
+            REQUIRE(it0 != tree0.end());
+            REQUIRE(it1 != tree1.end());
+            const std::string s0(reinterpret_cast<const char*>(it0->second.val.data()), it0->second.val.size());
+            const std::string s1(reinterpret_cast<const char*>(it1->second.val.data()), it1->second.val.size());
+            CHECK(s0 == v);
+            CHECK(s1 == v);
+        }
+    }
+}
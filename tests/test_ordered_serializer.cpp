@@ -0,0 +1,121 @@
+// tests/test_ordered_serializer.cpp
+#include "tests.hpp"
+
+#include "fulla/core/bytes.hpp"
+#include "fulla/codec/data_view.hpp"
+#include "fulla/codec/ordered_serializer.hpp"
+#include "fulla/codec/prop.hpp"
+#include "fulla/page/ranges.hpp"
+
+#include <compare>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace fulla::core;
+using namespace fulla::codec;
+using namespace fulla::codec::prop;
+
+namespace {
+
+    std::strong_ordering memcmp_order(const rec& lhs, const rec& rhs) {
+        return fulla::page::bytewise_less{}.compare(lhs.view(), rhs.view());
+    }
+
+    // the order of the encoded keys must be the order of the typed records
+    template <typename... Ts>
+    void check_same_order(const std::tuple<Ts...>& lhs, const std::tuple<Ts...>& rhs) {
+        const auto typed_l = std::apply([](auto&&... xs) { return make_record(xs...); }, lhs);
+        const auto typed_r = std::apply([](auto&&... xs) { return make_record(xs...); }, rhs);
+        const auto ordered_l = std::apply([](auto&&... xs) { return make_ordered_record(xs...); }, lhs);
+        const auto ordered_r = std::apply([](auto&&... xs) { return make_ordered_record(xs...); }, rhs);
+
+        const auto typed = data_view::compare_sequence(typed_l.view(), typed_r.view());
+        const auto ordered = memcmp_order(ordered_l, ordered_r);
+        CHECK(std::is_lt(typed) == std::is_lt(ordered));
+        CHECK(std::is_gt(typed) == std::is_gt(ordered));
+        CHECK(std::is_eq(typed) == std::is_eq(ordered));
+    }
+}
+
+TEST_SUITE("codec: ordered_serializer") {
+
+    TEST_CASE("integers: signed and unsigned keep their order") {
+        std::mt19937_64 rng(0x0DE5);
+        const std::vector<std::int64_t> edges = {
+            std::numeric_limits<std::int64_t>::min(), -1, 0, 1, std::numeric_limits<std::int64_t>::max()
+        };
+        for (auto a : edges) {
+            for (auto b : edges) {
+                check_same_order(std::make_tuple(i64{ a }), std::make_tuple(i64{ b }));
+            }
+        }
+        for (int i = 0; i < 1000; ++i) {
+            const auto a = rng();
+            const auto b = rng();
+            check_same_order(std::make_tuple(ui64{ a }), std::make_tuple(ui64{ b }));
+            check_same_order(std::make_tuple(i64{ static_cast<std::int64_t>(a) }), std::make_tuple(i64{ static_cast<std::int64_t>(b) }));
+            check_same_order(std::make_tuple(ui32{ static_cast<std::uint32_t>(a) }), std::make_tuple(ui32{ static_cast<std::uint32_t>(b) }));
+            check_same_order(std::make_tuple(i32{ static_cast<std::int32_t>(a) }), std::make_tuple(i32{ static_cast<std::int32_t>(b) }));
+        }
+    }
+
+    TEST_CASE("floats: negative, zero and positive values") {
+        const std::vector<double> values = {
+            -std::numeric_limits<double>::infinity(), -1e300, -2.5, -1.0, -1e-300, -0.0,
+            0.0, 1e-300, 1.0, 2.5, 1e300, std::numeric_limits<double>::infinity()
+        };
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            for (std::size_t j = 0; j < values.size(); ++j) {
+                check_same_order(std::make_tuple(fp64{ values[i] }), std::make_tuple(fp64{ values[j] }));
+                check_same_order(std::make_tuple(fp32{ static_cast<float>(values[i]) }),
+                    std::make_tuple(fp32{ static_cast<float>(values[j]) }));
+            }
+        }
+        CHECK(make_ordered_record(fp64{ -0.0 }).buf == make_ordered_record(fp64{ 0.0 }).buf);
+        const auto nan = make_ordered_record(fp64{ std::numeric_limits<double>::quiet_NaN() });
+        CHECK(std::is_gt(memcmp_order(nan, make_ordered_record(fp64{ std::numeric_limits<double>::infinity() }))));
+    }
+
+    TEST_CASE("strings: prefixes and embedded zeros") {
+        const std::vector<std::string> values = {
+            "", std::string(1, '\0'), std::string("a\0", 2), "a", std::string("a\0b", 3), "a\x01", "ab", "b", "\xff"
+        };
+        for (auto& a : values) {
+            for (auto& b : values) {
+                check_same_order(std::make_tuple(str{ a }), std::make_tuple(str{ b }));
+                check_same_order(std::make_tuple(str{ a }, ui32{ 1 }), std::make_tuple(str{ b }, ui32{ 0 }));
+            }
+        }
+    }
+
+    TEST_CASE("tuples and mixed types") {
+        check_same_order(std::make_tuple(tuple{ str{ "id" }, ui32{ 42 } }), std::make_tuple(tuple{ str{ "id" }, ui32{ 43 } }));
+        check_same_order(std::make_tuple(tuple{ str{ "id" } }), std::make_tuple(tuple{ str{ "id" }, ui32{ 0 } }));
+        check_same_order(std::make_tuple(tuple{ i32{ 10 }, tuple{ str{ "aaa" } } }),
+            std::make_tuple(tuple{ i32{ 10 }, tuple{ str{ "aab" } } }));
+        // different types order by type id
+        check_same_order(std::make_tuple(tuple{ str{ "zzz" } }), std::make_tuple(tuple{ i32{ 0 } }));
+
+        std::mt19937 rng(0xC0DE);
+        std::uniform_int_distribution<int> small(-3, 3);
+        for (int i = 0; i < 500; ++i) {
+            check_same_order(
+                std::make_tuple(tuple{ i32{ small(rng) }, str{ std::string(small(rng) + 3, 'x') } }, i64{ small(rng) }),
+                std::make_tuple(tuple{ i32{ small(rng) }, str{ std::string(small(rng) + 3, 'x') } }, i64{ small(rng) }));
+        }
+    }
+
+    TEST_CASE("append_record re-encodes serialized records") {
+        const auto typed = make_record(str{ "key" }, tuple{ i32{ -5 }, fp64{ 1.5 } }, blob{ make_record(ui64{ 7 }).view() });
+        const auto expected = make_ordered_record(str{ "key" }, tuple{ i32{ -5 }, fp64{ 1.5 } }, blob{ make_record(ui64{ 7 }).view() });
+
+        ordered_serializer os;
+        REQUIRE(os.append_record(typed.view()));
+        CHECK(std::ranges::equal(os.view(), expected.view()));
+
+        ordered_serializer broken;
+        CHECK_FALSE(broken.append_record(typed.view().first(typed.view().size() - 1)));
+    }
+}